@@ -0,0 +1,215 @@
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <new>
+
+AllocationTracker AllocationTracker::tracker;
+
+static thread_local AllocationTracker::Counts threadCounts;
+
+AllocationTracker::Counts AllocationTracker::GetThreadCounts() noexcept
+{
+	return threadCounts;
+}
+
+AllocationTracker::Counts AllocationTracker::GetTotalCounts() noexcept
+{
+	Counts counts;
+	counts.allocations = tracker.allocations.load(std::memory_order_relaxed);
+	counts.frees = tracker.frees.load(std::memory_order_relaxed);
+	counts.bytes = tracker.bytes.load(std::memory_order_relaxed);
+	return counts;
+}
+
+bool AllocationTracker::IsEnabled() noexcept
+{
+	return ALLOCATION_TRACKING_ENABLED != 0;
+}
+
+void AllocationTracker::OnAllocate(size_t size) noexcept
+{
+	threadCounts.allocations++;
+	threadCounts.bytes += size;
+	tracker.allocations.fetch_add(1, std::memory_order_relaxed);
+	tracker.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::OnFree() noexcept
+{
+	threadCounts.frees++;
+	tracker.frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope() noexcept :
+	start(AllocationTracker::GetThreadCounts())
+{
+}
+
+uint64_t AllocationScope::GetAllocations() const noexcept
+{
+	return AllocationTracker::GetThreadCounts().allocations - start.allocations;
+}
+
+uint64_t AllocationScope::GetBytes() const noexcept
+{
+	return AllocationTracker::GetThreadCounts().bytes - start.bytes;
+}
+
+#if ALLOCATION_TRACKING_ENABLED
+
+//Every form of the global operator new and delete is replaced, so none of them skip the counts
+static void* Allocate(size_t size) noexcept
+{
+	AllocationTracker::OnAllocate(size);
+	return std::malloc(size != 0 ? size : 1);
+}
+
+static void* AllocateAligned(size_t size, size_t alignment) noexcept
+{
+	AllocationTracker::OnAllocate(size);
+#ifdef _WIN32
+	return _aligned_malloc(size != 0 ? size : 1, alignment);
+#else
+	//aligned_alloc needs the size to be a multiple of the alignment
+	return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+}
+
+static void Free(void* pMemory) noexcept
+{
+	if (pMemory != nullptr)
+	{
+		AllocationTracker::OnFree();
+		std::free(pMemory);
+	}
+}
+
+static void FreeAligned(void* pMemory) noexcept
+{
+	if (pMemory != nullptr)
+	{
+		AllocationTracker::OnFree();
+#ifdef _WIN32
+		_aligned_free(pMemory);
+#else
+		std::free(pMemory);
+#endif
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (void* pMemory = Allocate(size))
+	{
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* pMemory = Allocate(size))
+	{
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	if (void* pMemory = AllocateAligned(size, static_cast<size_t>(alignment)))
+	{
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	if (void* pMemory = AllocateAligned(size, static_cast<size_t>(alignment)))
+	{
+		return pMemory;
+	}
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return AllocateAligned(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* pMemory) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete(void* pMemory, const std::nothrow_t&) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete[](void* pMemory, const std::nothrow_t&) noexcept
+{
+	Free(pMemory);
+}
+
+void operator delete(void* pMemory, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete(void* pMemory, size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t, std::align_val_t) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete(void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+void operator delete[](void* pMemory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	FreeAligned(pMemory);
+}
+
+#endif
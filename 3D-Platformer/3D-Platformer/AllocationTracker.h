@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+//Build with ALLOCATION_TRACKING_ENABLED defined as 0 to leave the global operator new and delete alone
+#ifndef ALLOCATION_TRACKING_ENABLED
+#define ALLOCATION_TRACKING_ENABLED 1
+#endif
+
+//Counts heap allocations made through operator new, for the whole program and for each thread
+//Counting a thread's allocations takes no locks, so a scope can be measured on a hot path
+class AllocationTracker
+{
+public:
+	struct Counts
+	{
+		uint64_t allocations = 0;
+		uint64_t frees = 0;
+		uint64_t bytes = 0;
+	};
+public:
+	//Allocations made by the calling thread, and frees of memory on it, since it started
+	static Counts GetThreadCounts() noexcept;
+	static Counts GetTotalCounts() noexcept;
+	static bool IsEnabled() noexcept;
+
+	//Called by the replaced operator new and delete
+	static void OnAllocate(size_t size) noexcept;
+	static void OnFree() noexcept;
+private:
+	//Atomics and a constexpr constructor make this constant initialised, so it is ready before any allocation
+	constexpr AllocationTracker() = default;
+private:
+	static AllocationTracker tracker;												//Allocation tracker singleton
+
+	std::atomic<uint64_t> allocations = 0;
+	std::atomic<uint64_t> frees = 0;
+	std::atomic<uint64_t> bytes = 0;
+};
+
+//Allocations made by the calling thread between construction and each query
+class AllocationScope
+{
+public:
+	AllocationScope() noexcept;
+	uint64_t GetAllocations() const noexcept;
+	uint64_t GetBytes() const noexcept;
+private:
+	AllocationTracker::Counts start;
+};
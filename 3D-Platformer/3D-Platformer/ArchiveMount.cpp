@@ -0,0 +1,60 @@
+#include "ArchiveMount.h"
+
+ArchiveMount::ArchiveMount(const std::string& archivePath)
+{
+	archive.Open(archivePath);
+}
+
+bool ArchiveMount::IsOpen() const noexcept
+{
+	return archive.IsOpen();
+}
+
+bool ArchiveMount::Exists(const std::string& path) const
+{
+	return archive.Find(path) != nullptr;
+}
+
+bool ArchiveMount::Read(const std::string& path, BlockCache& cache, VirtualFile& file) const
+{
+	const AssetArchive::Entry* pEntry = archive.Find(path);
+	if (pEntry == nullptr)
+	{
+		return false;
+	}
+
+	//Zero copy, the OS page cache already caches the mapping
+	if (const uint8_t* pMapped = archive.GetMappedData(*pEntry))
+	{
+		file = VirtualFile(pMapped, static_cast<size_t>(pEntry->size));
+		return true;
+	}
+
+	//Entries are unique per archive instance, so the hash and the archive's address identify the data
+	const uint64_t fileKey = pEntry->hash ^ reinterpret_cast<uintptr_t>(this);
+	std::vector<uint8_t> data(static_cast<size_t>(pEntry->size));
+
+	bool cached = true;
+	for (size_t offset = 0; offset < data.size() && cached; offset += BlockCache::blockSize)
+	{
+		const size_t count = data.size() - offset < BlockCache::blockSize ? data.size() - offset : BlockCache::blockSize;
+		cached = cache.Lookup(fileKey, static_cast<uint32_t>(offset / BlockCache::blockSize), data.data() + offset, count);
+	}
+
+	//LZ4 blocks can only be decompressed whole, so any missing block means decompressing the entry
+	if (!cached)
+	{
+		if (!archive.Read(*pEntry, data))
+		{
+			return false;
+		}
+		for (size_t offset = 0; offset < data.size(); offset += BlockCache::blockSize)
+		{
+			const size_t count = data.size() - offset < BlockCache::blockSize ? data.size() - offset : BlockCache::blockSize;
+			cache.Insert(fileKey, static_cast<uint32_t>(offset / BlockCache::blockSize), data.data() + offset, count);
+		}
+	}
+
+	file = VirtualFile(std::move(data));
+	return true;
+}
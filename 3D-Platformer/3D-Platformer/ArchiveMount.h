@@ -0,0 +1,16 @@
+#pragma once
+#include "FileMount.h"
+#include "AssetArchive.h"
+
+//Serves files from a packed AssetArchive
+//Uncompressed entries are returned as views of the mapping, compressed ones are cached after decompression
+class ArchiveMount : public FileMount
+{
+public:
+	ArchiveMount(const std::string& archivePath);
+	bool IsOpen() const noexcept;
+	bool Exists(const std::string& path) const override;
+	bool Read(const std::string& path, BlockCache& cache, VirtualFile& file) const override;
+private:
+	AssetArchive archive;
+};
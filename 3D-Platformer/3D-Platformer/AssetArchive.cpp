@@ -0,0 +1,146 @@
+#include "AssetArchive.h"
+#include "FilePath.h"
+#include "Lz4.h"
+#include <algorithm>
+#include <cstring>
+
+bool AssetArchive::Open(const std::string& path)
+{
+	pHeader = nullptr;
+	pEntries = nullptr;
+	pNames = nullptr;
+
+	if (!file.Open(path))
+	{
+		return false;
+	}
+
+	const uint8_t* pData = file.GetData();
+	const size_t size = file.GetSize();
+
+	//Validate the header and that every table lies inside the file
+	if (size < sizeof(Header))
+	{
+		file.Close();
+		return false;
+	}
+
+	const Header* pFileHeader = reinterpret_cast<const Header*>(pData);
+	if (memcmp(pFileHeader->magic, "PAK1", 4) != 0 || pFileHeader->version != version)
+	{
+		file.Close();
+		return false;
+	}
+
+	const uint64_t indexSize = uint64_t(pFileHeader->entryCount) * sizeof(Entry);
+	if (pFileHeader->indexOffset % alignof(Entry) != 0 ||
+		pFileHeader->indexOffset > size || indexSize > size - pFileHeader->indexOffset ||
+		pFileHeader->namesOffset > size || pFileHeader->namesSize > size - pFileHeader->namesOffset)
+	{
+		file.Close();
+		return false;
+	}
+
+	const Entry* pFileEntries = reinterpret_cast<const Entry*>(pData + pFileHeader->indexOffset);
+	for (uint32_t i = 0; i < pFileHeader->entryCount; i++)
+	{
+		const Entry& entry = pFileEntries[i];
+		if (entry.offset > size || entry.storedSize > size - entry.offset ||
+			uint64_t(entry.nameOffset) + entry.nameLength > pFileHeader->namesSize)
+		{
+			file.Close();
+			return false;
+		}
+	}
+
+	pHeader = pFileHeader;
+	pEntries = pFileEntries;
+	pNames = reinterpret_cast<const char*>(pData + pFileHeader->namesOffset);
+	return true;
+}
+
+bool AssetArchive::IsOpen() const noexcept
+{
+	return pHeader != nullptr;
+}
+
+const AssetArchive::Entry* AssetArchive::Find(const std::string& path) const noexcept
+{
+	if (!IsOpen())
+	{
+		return nullptr;
+	}
+
+	const std::string name = FilePath::ToLower(FilePath::Normalise(path));
+	const uint64_t hash = HashPath(name);
+
+	//Binary search the sorted index, then compare names to rule out hash collisions
+	const Entry* pEnd = pEntries + pHeader->entryCount;
+	const Entry* pEntry = std::lower_bound(pEntries, pEnd, hash,
+		[](const Entry& entry, uint64_t value) { return entry.hash < value; });
+
+	for (; pEntry != pEnd && pEntry->hash == hash; pEntry++)
+	{
+		if (pEntry->nameLength == name.size() && FilePath::ToLower(GetName(*pEntry)) == name)
+		{
+			return pEntry;
+		}
+	}
+	return nullptr;
+}
+
+//Zero copy pointer into the mapping, only available for uncompressed entries
+const uint8_t* AssetArchive::GetMappedData(const Entry& entry) const noexcept
+{
+	if (entry.flags & Compressed)
+	{
+		return nullptr;
+	}
+	return file.GetData() + entry.offset;
+}
+
+bool AssetArchive::Read(const Entry& entry, std::vector<uint8_t>& out) const
+{
+	const uint8_t* pStored = file.GetData() + entry.offset;
+	out.resize(static_cast<size_t>(entry.size));
+
+	if (entry.flags & Compressed)
+	{
+		return Lz4::Decompress(pStored, static_cast<size_t>(entry.storedSize), out.data(), out.size());
+	}
+
+	if (entry.storedSize != entry.size)
+	{
+		return false;
+	}
+	memcpy(out.data(), pStored, out.size());
+	return true;
+}
+
+size_t AssetArchive::GetEntryCount() const noexcept
+{
+	return IsOpen() ? pHeader->entryCount : 0;
+}
+
+const AssetArchive::Entry& AssetArchive::GetEntry(size_t index) const noexcept
+{
+	return pEntries[index];
+}
+
+std::string AssetArchive::GetName(const Entry& entry) const
+{
+	return std::string(pNames + entry.nameOffset, entry.nameLength);
+}
+
+//64 bit FNV-1a of the lower case path
+uint64_t AssetArchive::HashPath(const std::string& normalisedPath) noexcept
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : normalisedPath)
+	{
+		c = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+		hash ^= static_cast<uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "MappedFile.h"
+#include <string>
+#include <vector>
+
+//Packed asset archive
+//Layout: Header | Entry index sorted by path hash | Path names | Entry data
+//Paths are hashed and compared case insensitively after FilePath::Normalise
+//Uncompressed entries start on a 4K boundary so they can be used directly from the memory mapping
+class AssetArchive
+{
+public:
+	static constexpr uint32_t version = 2;
+	static constexpr uint32_t alignment = 4096;
+
+	enum EntryFlags : uint32_t
+	{
+		Compressed = 1u << 0
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t entryCount;
+		uint32_t alignment;
+		uint64_t indexOffset;
+		uint64_t namesOffset;
+		uint64_t namesSize;
+	};
+
+	struct Entry
+	{
+		uint64_t hash;
+		uint64_t offset;
+		uint64_t storedSize;
+		uint64_t size;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		uint32_t flags;
+		uint32_t reserved;
+	};
+public:
+	AssetArchive() = default;
+	AssetArchive(const AssetArchive&) = delete;
+	AssetArchive& operator=(const AssetArchive&) = delete;
+
+	bool Open(const std::string& path);
+	bool IsOpen() const noexcept;
+	const Entry* Find(const std::string& path) const noexcept;
+	const uint8_t* GetMappedData(const Entry& entry) const noexcept;
+	bool Read(const Entry& entry, std::vector<uint8_t>& out) const;
+	size_t GetEntryCount() const noexcept;
+	const Entry& GetEntry(size_t index) const noexcept;
+	std::string GetName(const Entry& entry) const;
+
+	static uint64_t HashPath(const std::string& normalisedPath) noexcept;
+private:
+	MappedFile file;
+	const Header* pHeader = nullptr;
+	const Entry* pEntries = nullptr;
+	const char* pNames = nullptr;
+};
@@ -0,0 +1,112 @@
+#include "BlockCache.h"
+#include <cstring>
+
+BlockCache::BlockCache(size_t capacityBytes) :
+	capacity(capacityBytes)
+{
+}
+
+bool BlockCache::Lookup(uint64_t fileKey, uint32_t blockIndex, uint8_t* pDst, size_t size)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const auto it = lookup.find(MakeKey(fileKey, blockIndex));
+	if (it == lookup.end())
+	{
+		missCount++;
+		return false;
+	}
+
+	//Key collisions are ruled out by comparing the full identity of the block
+	const Block& block = *it->second;
+	if (block.fileKey != fileKey || block.blockIndex != blockIndex || block.data.size() != size)
+	{
+		missCount++;
+		return false;
+	}
+
+	hitCount++;
+	memcpy(pDst, block.data.data(), size);
+	blocks.splice(blocks.begin(), blocks, it->second);
+	return true;
+}
+
+void BlockCache::Insert(uint64_t fileKey, uint32_t blockIndex, const uint8_t* pSrc, size_t size)
+{
+	if (size > capacity)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const uint64_t key = MakeKey(fileKey, blockIndex);
+	const auto it = lookup.find(key);
+	if (it != lookup.end())
+	{
+		usedBytes -= it->second->data.size();
+		blocks.erase(it->second);
+		lookup.erase(it);
+	}
+
+	blocks.push_front(Block{ fileKey, blockIndex, std::vector<uint8_t>(pSrc, pSrc + size) });
+	lookup[key] = blocks.begin();
+	usedBytes += size;
+
+	EvictToCapacity();
+}
+
+void BlockCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	blocks.clear();
+	lookup.clear();
+	usedBytes = 0;
+}
+
+void BlockCache::SetCapacity(size_t capacityBytes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	capacity = capacityBytes;
+	EvictToCapacity();
+}
+
+size_t BlockCache::GetCapacity() const noexcept
+{
+	return capacity;
+}
+
+size_t BlockCache::GetUsedBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return usedBytes;
+}
+
+uint64_t BlockCache::GetHitCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return hitCount;
+}
+
+uint64_t BlockCache::GetMissCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return missCount;
+}
+
+uint64_t BlockCache::MakeKey(uint64_t fileKey, uint32_t blockIndex) noexcept
+{
+	return fileKey ^ (uint64_t(blockIndex) * 0x9E3779B97F4A7C15ull);
+}
+
+//Drop least recently used blocks until the cache fits, mutex must be held
+void BlockCache::EvictToCapacity()
+{
+	while (usedBytes > capacity && !blocks.empty())
+	{
+		const Block& oldest = blocks.back();
+		usedBytes -= oldest.data.size();
+		lookup.erase(MakeKey(oldest.fileKey, oldest.blockIndex));
+		blocks.pop_back();
+	}
+}
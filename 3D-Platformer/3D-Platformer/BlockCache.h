@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+//Fixed size LRU cache of file blocks shared by all mounts
+//Mounts build file keys from a file's identity and version so stale data is never returned
+class BlockCache
+{
+public:
+	static constexpr size_t blockSize = 64 * 1024;
+
+	BlockCache(size_t capacityBytes);
+	BlockCache(const BlockCache&) = delete;
+	BlockCache& operator=(const BlockCache&) = delete;
+
+	bool Lookup(uint64_t fileKey, uint32_t blockIndex, uint8_t* pDst, size_t size);
+	void Insert(uint64_t fileKey, uint32_t blockIndex, const uint8_t* pSrc, size_t size);
+	void Clear();
+	void SetCapacity(size_t capacityBytes);
+	size_t GetCapacity() const noexcept;
+	size_t GetUsedBytes() const;
+	uint64_t GetHitCount() const;
+	uint64_t GetMissCount() const;
+private:
+	struct Block
+	{
+		uint64_t fileKey;
+		uint32_t blockIndex;
+		std::vector<uint8_t> data;
+	};
+
+	static uint64_t MakeKey(uint64_t fileKey, uint32_t blockIndex) noexcept;
+	void EvictToCapacity();
+private:
+	mutable std::mutex mutex;
+	size_t capacity;
+	size_t usedBytes = 0;
+	uint64_t hitCount = 0;
+	uint64_t missCount = 0;
+
+	//Front of the list is the most recently used block
+	std::list<Block> blocks;
+	std::unordered_map<uint64_t, std::list<Block>::iterator> lookup;
+};
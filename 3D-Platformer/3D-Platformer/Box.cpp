@@ -9,11 +9,12 @@
 #include "VertexBuffer.h"
 #include "VertexShader.h"
 
-Box::Box(Graphics& gfx, float _x, float _y, float _z) :
-	xPos(_x),
-	yPos(_y),
-	zPos(_z)
+Box::Box(Graphics& gfx, float _x, float _y, float _z)
 {
+	xPos = _x;
+	yPos = _y;
+	zPos = _z;
+
 	if (!IsStaticInitialised())
 	{
 		struct Vertex
@@ -170,7 +171,7 @@ Box::Box(Graphics& gfx, float _x, float _y, float _z) :
 	}
 
 	//Bind transform buffer
-	AddBind(std::make_unique<TransformCbuf>(gfx, *this));
+	AddBind(std::make_unique<TransformCbuf>(gfx));
 
 	//Model deformation transform (Instance)
 	DirectX::XMStoreFloat3x3(
@@ -186,26 +187,22 @@ void Box::SetVelocity(float _x, float _y, float _z)
 	zVel = _z;
 }
 
-void Box::SetPosition(float _x, float _y, float _z)
-{
-	xPos = _x;
-	yPos = _y;
-	zPos = _z;
-}
-
 void Box::SetEularX(float angle)
 {
 	xRot += angle;
+	MarkTransformDirty();
 }
 
 void Box::SetEularY(float angle)
 {
 	yRot += angle;
+	MarkTransformDirty();
 }
 
 void Box::SetEularZ(float angle)
 {
 	zRot += angle;
+	MarkTransformDirty();
 }
 
 void Box::Update(float dt) noexcept
@@ -215,6 +212,7 @@ void Box::Update(float dt) noexcept
 	xPos += xVel * dt;
 	yPos += yVel * dt;
 	zPos += zVel * dt;
+	MarkTransformDirty();
 }
 
 DirectX::XMMATRIX Box::GetTransformXM() const noexcept
@@ -12,12 +12,13 @@
 
 Bridge::Bridge(Graphics& gfx, std::wstring _textureName, float _x, float _y, float _z) :
 	textureName(_textureName),
-	xPos(_x),
-	yPos(0),
 	yTarget(0),
-	bridgeHeight(_y),
-	zPos(_z)
+	bridgeHeight(_y)
 {
+	xPos = _x;
+	yPos = 0.0f;
+	zPos = _z;
+
 	//Create the vertex buffer
 	const float side = 0.5f;
 	vertices = std::vector<Vertex>
@@ -143,7 +144,7 @@ Bridge::Bridge(Graphics& gfx, std::wstring _textureName, float _x, float _y, flo
 	}
 
 	//Bind transform buffer
-	AddBind(std::make_unique<TransformCbuf>(gfx, *this));
+	AddBind(std::make_unique<TransformCbuf>(gfx));
 
 	//Model deformation transform (Instance)
 	DirectX::XMStoreFloat3x3(
@@ -158,14 +159,7 @@ Bridge::Bridge(Graphics& gfx, std::wstring _textureName, float _x, float _y, flo
 	}
 
 	CreateBoundingBox(verticePositions);
-	CalculateAABB(GetTransformXM());
-}
-
-void Bridge::SetPosition(float _x, float _y, float _z)
-{
-	xPos = _x;
-	yPos = _y;
-	zPos = _z;
+	MarkTransformDirty();
 }
 
 void Bridge::RaiseBridge(float _speed)
@@ -177,16 +171,19 @@ void Bridge::RaiseBridge(float _speed)
 void Bridge::SetEularX(float angle)
 {
 	xRot = angle;
+	MarkTransformDirty();
 }
 
 void Bridge::SetEularY(float angle)
 {
 	yRot = angle;
+	MarkTransformDirty();
 }
 
 void Bridge::SetEularZ(float angle)
 {
 	zRot = angle;
+	MarkTransformDirty();
 }
 
 void Bridge::Update(float dt) noexcept
@@ -212,7 +209,7 @@ void Bridge::Update(float dt) noexcept
 			}
 		}
 
-		CalculateAABB(GetTransformXM());
+		MarkTransformDirty();
 	}
 }
 
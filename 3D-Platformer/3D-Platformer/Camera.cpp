@@ -7,12 +7,13 @@ Camera::Camera(Player* _player)
 
 DirectX::XMMATRIX Camera::GetMatrix() const
 {
+	const DirectX::XMMATRIX playerTransform = player->GetWorldMatrix();
 	const DirectX::XMVECTOR position = DirectX::XMVector3Transform(
 		DirectX::XMVectorSet(0.0, height, -radius, 0.0f),
-		player->GetTransformXM()
+		playerTransform
 	);
 
-	const DirectX::XMVECTOR focusPosition = DirectX::XMVector3Transform(DirectX::XMVectorZero(), player->GetTransformXM());
+	const DirectX::XMVECTOR focusPosition = DirectX::XMVector3Transform(DirectX::XMVectorZero(), playerTransform);
 
 	//Second parameter is a location to look at, can pass in an object transform
 	//Third parameter is an up transformation
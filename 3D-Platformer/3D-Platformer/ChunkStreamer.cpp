@@ -0,0 +1,314 @@
+#include "ChunkStreamer.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+ChunkStreamer::ChunkStreamer(const LevelData& _levelData, const Settings& _settings) :
+	levelData(_levelData),
+	settings(_settings)
+{
+	settings.chunkSize = (std::max)(settings.chunkSize, 1u);
+	settings.unloadRadius = (std::max)(settings.unloadRadius, settings.loadRadius);
+	chunkCountX = (levelData.GetWidth() + settings.chunkSize - 1) / settings.chunkSize;
+	chunkCountZ = (levelData.GetDepth() + settings.chunkSize - 1) / settings.chunkSize;
+
+	if (!settings.synchronous)
+	{
+		worker = std::thread(&ChunkStreamer::WorkerLoop, this);
+	}
+}
+
+ChunkStreamer::~ChunkStreamer()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workCondition.notify_all();
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+//Builds every chunk in range before returning, used when a level is first created
+//Chunks only read the level data, so they are built in parallel and added to the map afterwards
+void ChunkStreamer::LoadAround(float x, float z)
+{
+	std::vector<uint64_t> keys;
+	FindChunksToLoad(x, z, keys);
+	std::vector<std::unique_ptr<LevelChunk>> built(keys.size());
+
+	JobSystem::ParallelFor(keys.size(), 1, [this, &keys, &built](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			built[i] = std::make_unique<LevelChunk>(levelData, static_cast<uint32_t>(keys[i] >> 32), static_cast<uint32_t>(keys[i]), settings.chunkSize);
+		}
+	});
+
+	for (size_t i = 0; i < keys.size(); i++)
+	{
+		const size_t memoryBytes = built[i]->GetMemoryBytes();
+		committedBytes += memoryBytes;
+		loadedBytes += memoryBytes;
+		chunks[keys[i]] = { ChunkState::Loaded, memoryBytes, std::move(built[i]) };
+	}
+	RebuildLoadedList();
+}
+
+//Call once per frame from the main thread, returns the chunks that finished loading since the last call
+const std::vector<LevelChunk*>& ChunkStreamer::Update(float x, float z)
+{
+	newChunks.clear();
+
+	//Evict everything that has moved out of range
+	outOfRange.clear();
+	for (const auto& chunk : chunks)
+	{
+		if (GetDistance(static_cast<uint32_t>(chunk.first >> 32), static_cast<uint32_t>(chunk.first), x, z) > settings.unloadRadius)
+		{
+			outOfRange.push_back(chunk.first);
+		}
+	}
+	for (const uint64_t key : outOfRange)
+	{
+		Evict(key);
+	}
+
+	//Keep within budget if it has been lowered, dropping the furthest loaded chunks first
+	if (loadedBytes > settings.memoryBudget)
+	{
+		std::vector<std::pair<float, uint64_t>> byDistance;
+		for (const auto& chunk : chunks)
+		{
+			if (chunk.second.state == ChunkState::Loaded)
+			{
+				byDistance.push_back({ GetDistance(static_cast<uint32_t>(chunk.first >> 32), static_cast<uint32_t>(chunk.first), x, z), chunk.first });
+			}
+		}
+		std::sort(byDistance.begin(), byDistance.end());
+		while (loadedBytes > settings.memoryBudget && !byDistance.empty())
+		{
+			Evict(byDistance.back().second);
+			byDistance.pop_back();
+		}
+	}
+
+	//Queue chunks that have come into range
+	FindChunksToLoad(x, z, toLoad);
+	for (const uint64_t key : toLoad)
+	{
+		const size_t memoryBytes = LevelChunk::EstimateMemoryBytes(levelData, static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), settings.chunkSize);
+		committedBytes += memoryBytes;
+		chunks[key] = { ChunkState::Queued, memoryBytes, nullptr };
+	}
+
+	//Without a worker they are built here, nearest first
+	if (settings.synchronous)
+	{
+		for (const uint64_t key : toLoad)
+		{
+			ChunkEntry& entry = chunks[key];
+			entry.state = ChunkState::Loaded;
+			entry.pChunk = std::make_unique<LevelChunk>(levelData, static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), settings.chunkSize);
+			loadedBytes += entry.memoryBytes;
+			newChunks.push_back(entry.pChunk.get());
+		}
+		if (!outOfRange.empty() || !newChunks.empty())
+		{
+			RebuildLoadedList();
+		}
+		return newChunks;
+	}
+
+	//The two lists swap buffers back and forth, so both keep their capacity
+	completed.clear();
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		loadQueue.insert(loadQueue.end(), toLoad.begin(), toLoad.end());
+		completed.swap(completedChunks);
+	}
+	if (!toLoad.empty())
+	{
+		workCondition.notify_all();
+	}
+
+	//Chunks evicted while they were being built are thrown away
+	for (auto& pChunk : completed)
+	{
+		auto it = chunks.find(MakeKey(pChunk->GetChunkX(), pChunk->GetChunkZ()));
+		if (it == chunks.end() || it->second.state != ChunkState::Queued)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			evictedChunks.push_back(std::move(pChunk));
+			continue;
+		}
+
+		it->second.state = ChunkState::Loaded;
+		it->second.pChunk = std::move(pChunk);
+		loadedBytes += it->second.memoryBytes;
+		newChunks.push_back(it->second.pChunk.get());
+	}
+
+	if (!outOfRange.empty() || !newChunks.empty())
+	{
+		RebuildLoadedList();
+	}
+	return newChunks;
+}
+
+const std::vector<LevelChunk*>& ChunkStreamer::GetLoadedChunks() const noexcept
+{
+	return loadedChunks;
+}
+
+size_t ChunkStreamer::GetLoadedBytes() const noexcept
+{
+	return loadedBytes;
+}
+
+size_t ChunkStreamer::GetPendingCount() const noexcept
+{
+	return chunks.size() - loadedChunks.size();
+}
+
+uint64_t ChunkStreamer::MakeKey(uint32_t chunkX, uint32_t chunkZ) noexcept
+{
+	return (uint64_t(chunkX) << 32) | chunkZ;
+}
+
+//Distance from a point to the nearest edge of a chunk
+float ChunkStreamer::GetDistance(uint32_t chunkX, uint32_t chunkZ, float x, float z) const noexcept
+{
+	const float size = float(settings.chunkSize);
+	const float minX = chunkX * size - 0.5f;
+	const float minZ = chunkZ * size - 0.5f;
+	const float dx = (std::max)((std::max)(minX - x, x - (minX + size)), 0.0f);
+	const float dz = (std::max)((std::max)(minZ - z, z - (minZ + size)), 0.0f);
+	return std::sqrt(dx * dx + dz * dz);
+}
+
+//Chunks in range that are not loaded or queued yet, nearest first, cut off at the memory budget
+void ChunkStreamer::FindChunksToLoad(float x, float z, std::vector<uint64_t>& keys)
+{
+	candidates.clear();
+
+	const float size = float(settings.chunkSize);
+	const int32_t minX = (std::max)(int32_t(std::floor((x - settings.loadRadius) / size)), 0);
+	const int32_t maxX = (std::min)(int32_t(std::floor((x + settings.loadRadius) / size)), int32_t(chunkCountX) - 1);
+	const int32_t minZ = (std::max)(int32_t(std::floor((z - settings.loadRadius) / size)), 0);
+	const int32_t maxZ = (std::min)(int32_t(std::floor((z + settings.loadRadius) / size)), int32_t(chunkCountZ) - 1);
+
+	for (int32_t chunkZ = minZ; chunkZ <= maxZ; chunkZ++)
+	{
+		for (int32_t chunkX = minX; chunkX <= maxX; chunkX++)
+		{
+			const float distance = GetDistance(chunkX, chunkZ, x, z);
+			const uint64_t key = MakeKey(chunkX, chunkZ);
+			if (distance <= settings.loadRadius && chunks.find(key) == chunks.end())
+			{
+				candidates.push_back({ distance, key });
+			}
+		}
+	}
+	std::sort(candidates.begin(), candidates.end());
+
+	keys.clear();
+	size_t bytes = committedBytes;
+	for (const auto& candidate : candidates)
+	{
+		bytes += LevelChunk::EstimateMemoryBytes(levelData, static_cast<uint32_t>(candidate.second >> 32), static_cast<uint32_t>(candidate.second), settings.chunkSize);
+		if (bytes > settings.memoryBudget)
+		{
+			break;
+		}
+		keys.push_back(candidate.second);
+	}
+}
+
+void ChunkStreamer::Evict(uint64_t key)
+{
+	auto it = chunks.find(key);
+	if (it == chunks.end())
+	{
+		return;
+	}
+
+	committedBytes -= it->second.memoryBytes;
+	if (it->second.state == ChunkState::Loaded)
+	{
+		loadedBytes -= it->second.memoryBytes;
+	}
+	if (settings.synchronous)
+	{
+		chunks.erase(it);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (it->second.pChunk)
+		{
+			evictedChunks.push_back(std::move(it->second.pChunk));
+		}
+		loadQueue.erase(std::remove(loadQueue.begin(), loadQueue.end(), key), loadQueue.end());
+	}
+	workCondition.notify_all();
+	chunks.erase(it);
+}
+
+//Listed in chunk order rather than the map's, which depends on its history, so collisions are resolved in the same order every run
+void ChunkStreamer::RebuildLoadedList()
+{
+	loadedChunks.clear();
+	for (const auto& chunk : chunks)
+	{
+		if (chunk.second.state == ChunkState::Loaded)
+		{
+			loadedChunks.push_back(chunk.second.pChunk.get());
+		}
+	}
+	std::sort(loadedChunks.begin(), loadedChunks.end(), [](const LevelChunk* pA, const LevelChunk* pB)
+	{
+		return MakeKey(pA->GetChunkX(), pA->GetChunkZ()) < MakeKey(pB->GetChunkX(), pB->GetChunkZ());
+	});
+}
+
+void ChunkStreamer::WorkerLoop()
+{
+	PROFILE_THREAD("Chunk streamer");
+
+	while (true)
+	{
+		uint64_t key = 0;
+		bool hasWork = false;
+		std::vector<std::unique_ptr<LevelChunk>> chunksToDestroy;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workCondition.wait(lock, [this]() { return stopping || !loadQueue.empty() || !evictedChunks.empty(); });
+			if (stopping)
+			{
+				break;
+			}
+			chunksToDestroy.swap(evictedChunks);
+			if (!loadQueue.empty())
+			{
+				key = loadQueue.front();
+				loadQueue.pop_front();
+				hasWork = true;
+			}
+		}
+
+		chunksToDestroy.clear();
+
+		if (hasWork)
+		{
+			auto pChunk = std::make_unique<LevelChunk>(levelData, static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), settings.chunkSize);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			completedChunks.push_back(std::move(pChunk));
+		}
+	}
+}
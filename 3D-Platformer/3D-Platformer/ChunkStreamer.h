@@ -0,0 +1,84 @@
+#pragma once
+#include "LevelChunk.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//Keeps the chunks of a level around the player loaded
+//Chunks inside loadRadius are built on a worker thread, nearest first, and chunks outside unloadRadius are destroyed on it
+//The gap between the two radii stops chunks on the boundary from being reloaded as the player moves back and forth
+//Synchronous streamers have no worker, chunks come into range during the Update that finds them, so a replay loads the same chunks on the same frames
+class ChunkStreamer
+{
+public:
+	struct Settings
+	{
+		uint32_t chunkSize = 16;
+		float loadRadius = 32.0f;
+		float unloadRadius = 40.0f;
+		size_t memoryBudget = 64 * 1024 * 1024;
+		bool synchronous = false;
+	};
+public:
+	ChunkStreamer(const LevelData& _levelData, const Settings& _settings);
+	~ChunkStreamer();
+	ChunkStreamer(const ChunkStreamer&) = delete;
+	ChunkStreamer& operator=(const ChunkStreamer&) = delete;
+
+	void LoadAround(float x, float z);
+	const std::vector<LevelChunk*>& Update(float x, float z);
+	const std::vector<LevelChunk*>& GetLoadedChunks() const noexcept;
+	size_t GetLoadedBytes() const noexcept;
+	size_t GetPendingCount() const noexcept;
+private:
+	enum class ChunkState
+	{
+		Queued,
+		Loaded
+	};
+
+	struct ChunkEntry
+	{
+		ChunkState state;
+		size_t memoryBytes;
+		std::unique_ptr<LevelChunk> pChunk;
+	};
+private:
+	static uint64_t MakeKey(uint32_t chunkX, uint32_t chunkZ) noexcept;
+	float GetDistance(uint32_t chunkX, uint32_t chunkZ, float x, float z) const noexcept;
+	void FindChunksToLoad(float x, float z, std::vector<uint64_t>& keys);
+	void Evict(uint64_t key);
+	void RebuildLoadedList();
+	void WorkerLoop();
+private:
+	const LevelData& levelData;
+	Settings settings;
+	uint32_t chunkCountX;
+	uint32_t chunkCountZ;
+
+	//Only used by the main thread
+	std::unordered_map<uint64_t, ChunkEntry> chunks;
+	std::vector<LevelChunk*> loadedChunks;
+	std::vector<LevelChunk*> newChunks;
+	size_t committedBytes = 0;
+
+	//Reused every update so a frame without chunks arriving or leaving does not allocate
+	std::vector<uint64_t> outOfRange;
+	std::vector<uint64_t> toLoad;
+	std::vector<std::pair<float, uint64_t>> candidates;
+	std::vector<std::unique_ptr<LevelChunk>> completed;
+	size_t loadedBytes = 0;
+
+	//Shared with the worker
+	std::mutex mutex;
+	std::condition_variable workCondition;
+	std::deque<uint64_t> loadQueue;
+	std::vector<std::unique_ptr<LevelChunk>> completedChunks;
+	std::vector<std::unique_ptr<LevelChunk>> evictedChunks;
+	bool stopping = false;
+	std::thread worker;
+};
@@ -0,0 +1,113 @@
+#pragma once
+#include "MemoryTracker.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using Entity = uint32_t;
+
+//Components of one type packed contiguously, in no particular order
+//A sparse table maps an entity to its slot, removing swaps the last component into the hole so the array never has gaps
+template<class T>
+class ComponentArray
+{
+public:
+	static constexpr uint32_t invalidIndex = 0xFFFFFFFF;
+public:
+	T& Add(Entity entity, const T& component)
+	{
+		if (entity >= sparse.size())
+		{
+			sparse.resize(entity + 1, invalidIndex);
+		}
+		if (sparse[entity] != invalidIndex)
+		{
+			components[sparse[entity]] = component;
+			return components[sparse[entity]];
+		}
+
+		sparse[entity] = static_cast<uint32_t>(components.size());
+		components.push_back(component);
+		entities.push_back(entity);
+		return components.back();
+	}
+
+	void Remove(Entity entity)
+	{
+		if (!Has(entity))
+		{
+			return;
+		}
+
+		const uint32_t index = sparse[entity];
+		const uint32_t lastIndex = static_cast<uint32_t>(components.size() - 1);
+		if (index != lastIndex)
+		{
+			components[index] = components[lastIndex];
+			entities[index] = entities[lastIndex];
+			sparse[entities[index]] = index;
+		}
+		components.pop_back();
+		entities.pop_back();
+		sparse[entity] = invalidIndex;
+	}
+
+	void Clear() noexcept
+	{
+		components.clear();
+		entities.clear();
+		sparse.clear();
+	}
+
+	bool Has(Entity entity) const noexcept
+	{
+		return entity < sparse.size() && sparse[entity] != invalidIndex;
+	}
+
+	//Returns nullptr when the entity does not have this component
+	T* Find(Entity entity) noexcept
+	{
+		return Has(entity) ? &components[sparse[entity]] : nullptr;
+	}
+
+	const T* Find(Entity entity) const noexcept
+	{
+		return Has(entity) ? &components[sparse[entity]] : nullptr;
+	}
+
+	//Only valid for entities that have the component
+	T& Get(Entity entity) noexcept
+	{
+		return components[sparse[entity]];
+	}
+
+	const T& Get(Entity entity) const noexcept
+	{
+		return components[sparse[entity]];
+	}
+
+	//Systems walk the packed arrays by index, the entity at the same index owns the component
+	size_t GetSize() const noexcept
+	{
+		return components.size();
+	}
+
+	T& GetAt(size_t index) noexcept
+	{
+		return components[index];
+	}
+
+	const T& GetAt(size_t index) const noexcept
+	{
+		return components[index];
+	}
+
+	Entity GetEntityAt(size_t index) const noexcept
+	{
+		return entities[index];
+	}
+private:
+	TrackedVector<T, MemoryTracker::EntityCategory> components;
+	TrackedVector<Entity, MemoryTracker::EntityCategory> entities;
+	TrackedVector<uint32_t, MemoryTracker::EntityCategory> sparse;
+};
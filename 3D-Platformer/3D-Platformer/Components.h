@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+
+class GameObject;
+
+//Components are plain data so the simulation does not depend on the renderer
+struct Float3
+{
+	float x = 0.0f;
+	float y = 0.0f;
+	float z = 0.0f;
+};
+
+//Position, euler rotation and scale, applied scale first then rotation then translation like GameObject::GetTransformXM
+struct TransformComponent
+{
+	Float3 position;
+	Float3 rotation;
+	Float3 scale = { 1.0f, 1.0f, 1.0f };
+};
+
+//Rows of the world matrix built from the transform, the rotation axes scaled and then the translation
+//Cached by TransformSystem and only rebuilt when the entity is marked dirty
+struct WorldComponent
+{
+	Float3 axisX = { 1.0f, 0.0f, 0.0f };
+	Float3 axisY = { 0.0f, 1.0f, 0.0f };
+	Float3 axisZ = { 0.0f, 0.0f, 1.0f };
+	Float3 translation;
+};
+
+//Model space box of the mesh and the world space box around it, rebuilt by TransformSystem with the world matrix
+struct BoundsComponent
+{
+	Float3 modelMin;
+	Float3 modelMax;
+	Float3 worldMin;
+	Float3 worldMax;
+};
+
+//Mesh drawn with the entity's world matrix, several entities can share one mesh
+struct RenderableComponent
+{
+	GameObject* pMesh = nullptr;
+	bool visible = true;
+};
+
+enum ColliderType : uint8_t
+{
+	//Pushes the player out
+	SolidCollider,
+	//Only reports the overlap, for triggers
+	OverlapCollider
+};
+
+struct ColliderComponent
+{
+	ColliderType type = SolidCollider;
+};
+
+enum AnimatorGroup : uint8_t
+{
+	NoAnimatorGroup,
+	BridgeAnimatorGroup
+};
+
+//Slides the entity up or down to yTarget and spins it around y
+//Activating it, directly or through its group, sends it to activeY at activeSpeed
+struct AnimatorComponent
+{
+	float yTarget = 0.0f;
+	float speed = 1.0f;
+	float activeY = 0.0f;
+	float activeSpeed = 1.0f;
+	float spinSpeed = 0.0f;
+	AnimatorGroup group = NoAnimatorGroup;
+};
+
+enum TriggerAction : uint8_t
+{
+	//Hides the entity
+	CollectTrigger,
+	//Activates the entity's own animator and every animator in targetGroup
+	ActivateGroupTrigger,
+	//Ends the level
+	GoalTrigger
+};
+
+struct TriggerComponent
+{
+	TriggerAction action = CollectTrigger;
+	AnimatorGroup targetGroup = NoAnimatorGroup;
+	bool fired = false;
+};
@@ -1,5 +1,7 @@
 #pragma once
 #include "Bindable.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
 
 //Constant buffer class to be passed in as a template
 template<typename C>
@@ -22,6 +24,7 @@ public:
 		//Then you can write into the memory and call unmap once the process is finished
 		memcpy(msr.pData, &consts, sizeof(consts));
 		GetContext(gfx)->Unmap(pConstantBuffer, 0u);
+		PerfCounters::Add(PerfCounters::ConstantBufferBytesCounter, sizeof(consts));
 	}
 
 	//Constructor with constant buffer initialisation
@@ -39,6 +42,7 @@ public:
 		D3D11_SUBRESOURCE_DATA constantBufferData = {};
 		constantBufferData.pSysMem = &consts;
 		GetDevice(gfx)->CreateBuffer(&constantBufferDesc, &constantBufferData, &pConstantBuffer);
+		Track();
 	}
 
 	//Constructor without constant buffer initialisation
@@ -53,6 +57,7 @@ public:
 		constantBufferDesc.MiscFlags = 0u;
 
 		GetDevice(gfx)->CreateBuffer(&constantBufferDesc, nullptr, &pConstantBuffer);
+		Track();
 	}
 
 	//Deconstructor
@@ -61,9 +66,18 @@ public:
 		if (pConstantBuffer != nullptr)
 		{
 			pConstantBuffer->Release();
+			MemoryTracker::Remove(MemoryTracker::ConstantBufferCategory, sizeof(C));
 		}
 	}
 
+private:
+	void Track() noexcept
+	{
+		if (pConstantBuffer != nullptr)
+		{
+			MemoryTracker::Add(MemoryTracker::ConstantBufferCategory, sizeof(C));
+		}
+	}
 protected:
 	ID3D11Buffer* pConstantBuffer = nullptr;
 	UINT slot;
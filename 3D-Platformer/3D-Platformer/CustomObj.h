@@ -1,6 +1,6 @@
 #pragma once
 #include "GameObjectBase.h"
-#include <fstream>
+#include "ObjModel.h"
 #include <sstream>
 #include <string>
 
@@ -13,33 +13,9 @@ public:
 	void Update(float dt) noexcept override;
 	DirectX::XMMATRIX GetTransformXM() const noexcept override;
 private:
-	//Structure for vertex
-	struct Vertex
-	{
-		Vertex() {};
-		Vertex(
-			float x, float y, float z,
-			float u, float v) :
-			pos(x, y, z), texCoord(u, v) {}
-
-		DirectX::XMFLOAT3 pos;
-		DirectX::XMFLOAT2 texCoord;
-		DirectX::XMFLOAT3 normal;
-	};
-
-	struct SurfaceMaterial
-	{
-		std::wstring matName;
-		int numOfFaces;
-	};
-
-	//Material structure
-	struct Material
-	{
-		std::wstring matName;
-		DirectX::XMFLOAT4 difColor;
-		bool transparent;
-	};
+	using Vertex = ObjModel::Vertex;
+	using SurfaceMaterial = ObjModel::SurfaceMaterial;
+	using Material = ObjModel::Material;
 
 	std::vector<Material> materials;
 	std::vector<SurfaceMaterial> surfaceMaterials;
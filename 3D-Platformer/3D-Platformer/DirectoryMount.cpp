@@ -0,0 +1,111 @@
+#include "DirectoryMount.h"
+#include "AssetArchive.h"
+#include "FilePath.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+DirectoryMount::DirectoryMount(const std::string& _rootPath) :
+	rootPath(_rootPath)
+{
+}
+
+bool DirectoryMount::Exists(const std::string& path) const
+{
+	std::error_code error;
+	return std::filesystem::is_regular_file(GetFullPath(path), error);
+}
+
+bool DirectoryMount::Read(const std::string& path, BlockCache& cache, VirtualFile& file) const
+{
+	const std::string fullPath = GetFullPath(path);
+
+	std::error_code error;
+	const uintmax_t fileSize = std::filesystem::file_size(fullPath, error);
+	if (error)
+	{
+		return false;
+	}
+	const auto writeTime = std::filesystem::last_write_time(fullPath, error);
+	if (error)
+	{
+		return false;
+	}
+
+	//Editing a file changes its size or write time, which gives its blocks a new key
+	const uint64_t fileKey = AssetArchive::HashPath(fullPath) ^
+		(uint64_t(fileSize) * 0xFF51AFD7ED558CCDull) ^
+		static_cast<uint64_t>(writeTime.time_since_epoch().count());
+
+	std::vector<uint8_t> data(static_cast<size_t>(fileSize));
+	std::ifstream fileIn;
+
+	for (size_t offset = 0; offset < data.size(); offset += BlockCache::blockSize)
+	{
+		const uint32_t blockIndex = static_cast<uint32_t>(offset / BlockCache::blockSize);
+		const size_t count = data.size() - offset < BlockCache::blockSize ? data.size() - offset : BlockCache::blockSize;
+
+		if (cache.Lookup(fileKey, blockIndex, data.data() + offset, count))
+		{
+			continue;
+		}
+
+		//Only open the file once a block is missing from the cache
+		if (!fileIn.is_open())
+		{
+			fileIn.open(fullPath, std::ios::binary);
+			if (!fileIn)
+			{
+				return false;
+			}
+		}
+
+		fileIn.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+		if (!fileIn.read(reinterpret_cast<char*>(data.data() + offset), static_cast<std::streamsize>(count)))
+		{
+			return false;
+		}
+		cache.Insert(fileKey, blockIndex, data.data() + offset, count);
+	}
+
+	file = VirtualFile(std::move(data));
+	return true;
+}
+
+std::string DirectoryMount::GetFullPath(const std::string& path) const
+{
+	const std::string fullPath = rootPath.empty() ? path : rootPath + "/" + path;
+	std::error_code error;
+	if (std::filesystem::exists(fullPath, error))
+	{
+		return fullPath;
+	}
+
+	//Only paths spelt differently from the disk get here, each name is looked up in its directory
+	std::string resolvedPath = rootPath;
+	for (size_t begin = 0; begin <= path.size();)
+	{
+		const size_t end = (std::min)(path.find('/', begin), path.size());
+		const std::string name = FilePath::ToLower(path.substr(begin, end - begin));
+
+		std::string match;
+		std::filesystem::directory_iterator it(resolvedPath.empty() ? "." : resolvedPath, error);
+		for (; !error && it != std::filesystem::directory_iterator(); it.increment(error))
+		{
+			const std::string entryName = it->path().filename().string();
+			if (FilePath::ToLower(entryName) == name)
+			{
+				match = entryName;
+				break;
+			}
+		}
+		if (match.empty())
+		{
+			return fullPath;
+		}
+
+		resolvedPath = resolvedPath.empty() ? match : resolvedPath + "/" + match;
+		begin = end + 1;
+	}
+	return resolvedPath;
+}
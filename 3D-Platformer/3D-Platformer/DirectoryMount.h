@@ -0,0 +1,17 @@
+#pragma once
+#include "FileMount.h"
+
+//Serves loose files from a directory on disk, reads go through the block cache
+//Names are matched ignoring case like archive entries, so a path that opens from the pack also opens from loose files on a case sensitive file system
+class DirectoryMount : public FileMount
+{
+public:
+	DirectoryMount(const std::string& _rootPath);
+	bool Exists(const std::string& path) const override;
+	bool Read(const std::string& path, BlockCache& cache, VirtualFile& file) const override;
+private:
+	//The path on disk with each name spelt as it is there, or the path as given when nothing matches
+	std::string GetFullPath(const std::string& path) const;
+private:
+	std::string rootPath;
+};
@@ -0,0 +1,18 @@
+#pragma once
+#include "BlockCache.h"
+#include "VirtualFile.h"
+#include <string>
+
+//Backend that serves files for a mount point of the VirtualFileSystem
+//Paths passed in are normalised and relative to the mount point
+class FileMount
+{
+public:
+	FileMount() = default;
+	FileMount(const FileMount&) = delete;
+	FileMount& operator=(const FileMount&) = delete;
+	virtual ~FileMount() = default;
+
+	virtual bool Exists(const std::string& path) const = 0;
+	virtual bool Read(const std::string& path, BlockCache& cache, VirtualFile& file) const = 0;
+};
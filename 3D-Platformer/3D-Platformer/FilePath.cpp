@@ -0,0 +1,95 @@
+#include "FilePath.h"
+#include <vector>
+
+//"Images\\..\\Resources//Level1.txt" -> "Resources/Level1.txt"
+std::string FilePath::Normalise(const std::string& path)
+{
+	std::vector<std::string> parts;
+	std::string part;
+
+	for (size_t i = 0; i <= path.size(); i++)
+	{
+		const char c = i < path.size() ? path[i] : '/';
+		if (c != '/' && c != '\\')
+		{
+			part += c;
+			continue;
+		}
+
+		if (part == "..")
+		{
+			//Paths can't climb above the root of the file system
+			if (!parts.empty())
+			{
+				parts.pop_back();
+			}
+		}
+		else if (!part.empty() && part != ".")
+		{
+			parts.push_back(part);
+		}
+		part.clear();
+	}
+
+	std::string normalised;
+	for (const std::string& p : parts)
+	{
+		if (!normalised.empty())
+		{
+			normalised += '/';
+		}
+		normalised += p;
+	}
+	return normalised;
+}
+
+//Asset paths are plain ASCII
+std::string FilePath::Normalise(const std::wstring& path)
+{
+	std::string narrowPath;
+	narrowPath.reserve(path.size());
+	for (const wchar_t c : path)
+	{
+		narrowPath += static_cast<char>(c);
+	}
+	return Normalise(narrowPath);
+}
+
+//Lookups are case insensitive to match the Windows file system the assets are authored on
+std::string FilePath::ToLower(const std::string& path)
+{
+	std::string lower = path;
+	for (char& c : lower)
+	{
+		if (c >= 'A' && c <= 'Z')
+		{
+			c = c - 'A' + 'a';
+		}
+	}
+	return lower;
+}
+
+//True if prefix is a whole leading directory of path, an empty prefix matches everything
+bool FilePath::HasPrefix(const std::string& path, const std::string& prefix) noexcept
+{
+	if (prefix.empty())
+	{
+		return true;
+	}
+	if (path.size() <= prefix.size() || path[prefix.size()] != '/')
+	{
+		return false;
+	}
+	for (size_t i = 0; i < prefix.size(); i++)
+	{
+		char a = path[i];
+		char b = prefix[i];
+		a = (a >= 'A' && a <= 'Z') ? a - 'A' + 'a' : a;
+		b = (b >= 'A' && b <= 'Z') ? b - 'A' + 'a' : b;
+		if (a != b)
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <string>
+
+//Helpers for the virtual file system's path format: relative, '/' separated, no "." or ".." parts
+class FilePath
+{
+public:
+	static std::string Normalise(const std::string& path);
+	static std::string Normalise(const std::wstring& path);
+	static std::string ToLower(const std::string& path);
+	static bool HasPrefix(const std::string& path, const std::string& prefix) noexcept;
+};
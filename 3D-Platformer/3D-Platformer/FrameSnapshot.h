@@ -0,0 +1,19 @@
+#pragma once
+#include "RenderSystem.h"
+#include "TileRecord.h"
+#include <cstdint>
+#include <vector>
+
+//Everything the render thread needs to draw one simulated frame, copied so the simulation can move on straight away
+//Meshes are referenced, not copied, the simulation waits for the render thread before destroying a level
+struct FrameSnapshot
+{
+	uint64_t frameNumber = 0;
+	DirectX::XMFLOAT4X4 camera;
+	std::vector<DrawCommand> objects;
+	std::vector<TileRecord> tiles;
+
+	//Performance overlay, empty when it is hidden
+	bool showOverlay = false;
+	char overlayText[1024] = {};
+};
@@ -0,0 +1,168 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+static const char* const phaseNames[FrameStats::PhaseCount] = { "input", "streaming", "animation", "triggers", "collision", "camera", "publish" };
+
+FrameStats::PhaseTimer::PhaseTimer(FrameStats& _stats, Phase _phase) noexcept :
+	stats(_stats),
+	phase(_phase),
+	start(std::chrono::steady_clock::now())
+{
+}
+
+FrameStats::PhaseTimer::~PhaseTimer()
+{
+	stats.AddPhaseTime(phase, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count(), allocations.GetAllocations());
+}
+
+FrameStats::FrameStats(float _hitchMilliseconds, float _spikeMilliseconds) :
+	hitchMilliseconds(_hitchMilliseconds),
+	spikeMilliseconds(_spikeMilliseconds)
+{
+}
+
+void FrameStats::AddPhaseTime(Phase phase, float milliseconds, uint64_t allocations) noexcept
+{
+	current.phaseMilliseconds[phase] += milliseconds;
+	current.phaseAllocations[phase] += static_cast<uint32_t>(allocations);
+}
+
+void FrameStats::SetRenderMilliseconds(float milliseconds) noexcept
+{
+	lastRenderMilliseconds.store(milliseconds, std::memory_order_relaxed);
+}
+
+bool FrameStats::EndFrame(uint64_t frameNumber, float frameMilliseconds, float simMilliseconds, uint64_t allocations) noexcept
+{
+	current.frameNumber = frameNumber;
+	current.frameMilliseconds = frameMilliseconds;
+	current.simMilliseconds = simMilliseconds;
+	current.renderMilliseconds = lastRenderMilliseconds.load(std::memory_order_relaxed);
+	current.allocations = static_cast<uint32_t>(allocations);
+
+	for (int channel = 0; channel < ChannelCount; channel++)
+	{
+		if (GetValue(current, Channel(channel)) > hitchMilliseconds)
+		{
+			totalHitchCounts[channel]++;
+		}
+	}
+
+	frames[next] = current;
+	next = (next + 1) % capacity;
+	count = (std::min)(count + 1, capacity);
+	current = {};
+
+	framesSinceSpike = (std::min)(framesSinceSpike + 1, capacity);
+	if (frameMilliseconds > spikeMilliseconds && framesSinceSpike == capacity)
+	{
+		framesSinceSpike = 0;
+		return true;
+	}
+	return false;
+}
+
+size_t FrameStats::GetFrameCount() const noexcept
+{
+	return count;
+}
+
+const FrameStats::Frame& FrameStats::GetFrame(size_t index) const noexcept
+{
+	return frames[(next + capacity - count + index) % capacity];
+}
+
+//Nearest rank percentiles over the frames in the ring
+FrameStats::Summary FrameStats::GetSummary(Channel channel) noexcept
+{
+	Summary summary = {};
+	summary.frameCount = count;
+	summary.totalHitchCount = totalHitchCounts[channel];
+	if (count == 0)
+	{
+		return summary;
+	}
+
+	float total = 0.0f;
+	for (size_t i = 0; i < count; i++)
+	{
+		sorted[i] = GetValue(GetFrame(i), channel);
+		total += sorted[i];
+		if (sorted[i] > hitchMilliseconds)
+		{
+			summary.hitchCount++;
+		}
+	}
+	std::sort(sorted, sorted + count);
+
+	const auto percentile = [this](float fraction)
+	{
+		const size_t rank = size_t(std::ceil(fraction * count));
+		return sorted[(std::max)(rank, size_t(1)) - 1];
+	};
+
+	summary.mean = total / count;
+	summary.p50 = percentile(0.50f);
+	summary.p95 = percentile(0.95f);
+	summary.p99 = percentile(0.99f);
+	summary.max = sorted[count - 1];
+	return summary;
+}
+
+bool FrameStats::WriteRecentFrames(const std::string& path) const
+{
+	std::ofstream file(path);
+	if (!file)
+	{
+		return false;
+	}
+
+	file << "frame,frame ms,sim ms,render ms";
+	for (const char* name : phaseNames)
+	{
+		file << "," << name << " ms";
+	}
+	file << ",allocations";
+	for (const char* name : phaseNames)
+	{
+		file << "," << name << " allocations";
+	}
+	file << "\n";
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const Frame& frame = GetFrame(i);
+		file << frame.frameNumber << "," << frame.frameMilliseconds << "," << frame.simMilliseconds << "," << frame.renderMilliseconds;
+		for (const float milliseconds : frame.phaseMilliseconds)
+		{
+			file << "," << milliseconds;
+		}
+		file << "," << frame.allocations;
+		for (const uint32_t allocations : frame.phaseAllocations)
+		{
+			file << "," << allocations;
+		}
+		file << "\n";
+	}
+	return bool(file);
+}
+
+const char* FrameStats::GetPhaseName(Phase phase) noexcept
+{
+	return phaseNames[phase];
+}
+
+float FrameStats::GetValue(const Frame& frame, Channel channel) noexcept
+{
+	switch (channel)
+	{
+	case SimChannel:
+		return frame.simMilliseconds;
+	case RenderChannel:
+		return frame.renderMilliseconds;
+	default:
+		return frame.frameMilliseconds;
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "AllocationTracker.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//Keeps the timings of the last frames in a fixed ring, with rolling percentiles and hitch counts
+//Nothing here allocates after construction, so it can run every frame without showing up in what it measures
+class FrameStats
+{
+public:
+	//Parts of a simulation frame that are timed separately
+	enum Phase
+	{
+		InputPhase,
+		StreamingPhase,
+		AnimationPhase,
+		TriggerPhase,
+		CollisionPhase,
+		CameraPhase,
+		PublishPhase,
+		PhaseCount
+	};
+
+	enum Channel
+	{
+		FrameChannel,
+		SimChannel,
+		RenderChannel,
+		ChannelCount
+	};
+
+	struct Frame
+	{
+		uint64_t frameNumber;
+		float frameMilliseconds;
+		float simMilliseconds;
+		float renderMilliseconds;
+		float phaseMilliseconds[PhaseCount];
+		//Heap allocations made by the simulating thread
+		uint32_t allocations;
+		uint32_t phaseAllocations[PhaseCount];
+	};
+
+	struct Summary
+	{
+		size_t frameCount;
+		float mean;
+		float p50;
+		float p95;
+		float p99;
+		float max;
+		//Frames over the hitch threshold in the ring, and since the start
+		size_t hitchCount;
+		uint64_t totalHitchCount;
+	};
+
+	//Times one phase of the current frame from its construction to its destruction, and counts its allocations
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer(FrameStats& _stats, Phase _phase) noexcept;
+		~PhaseTimer();
+		PhaseTimer(const PhaseTimer&) = delete;
+		PhaseTimer& operator=(const PhaseTimer&) = delete;
+	private:
+		FrameStats& stats;
+		Phase phase;
+		std::chrono::steady_clock::time_point start;
+		AllocationScope allocations;
+	};
+public:
+	static constexpr size_t capacity = 600;
+public:
+	//Frames slower than hitchMilliseconds count as hitches, frames slower than spikeMilliseconds are reported as spikes
+	FrameStats(float _hitchMilliseconds = 1000.0f / 30.0f, float _spikeMilliseconds = 100.0f);
+
+	//Phases can run more than once a frame, their times are added up
+	void AddPhaseTime(Phase phase, float milliseconds, uint64_t allocations = 0) noexcept;
+	//Called by the render thread after each frame it draws, the next recorded frame picks it up
+	void SetRenderMilliseconds(float milliseconds) noexcept;
+	//Adds the current frame to the ring and starts the next one, returns true when it was a spike worth capturing
+	//A spike right after another one is not reported again until the ring has been refilled with frames after it
+	bool EndFrame(uint64_t frameNumber, float frameMilliseconds, float simMilliseconds, uint64_t allocations = 0) noexcept;
+
+	size_t GetFrameCount() const noexcept;
+	//Frames from the oldest kept, index 0, to the newest
+	const Frame& GetFrame(size_t index) const noexcept;
+	Summary GetSummary(Channel channel) noexcept;
+	//Writes the kept frames with every phase timing as CSV, oldest first
+	bool WriteRecentFrames(const std::string& path) const;
+
+	static const char* GetPhaseName(Phase phase) noexcept;
+private:
+	static float GetValue(const Frame& frame, Channel channel) noexcept;
+private:
+	Frame frames[capacity];
+	size_t next = 0;
+	size_t count = 0;
+
+	Frame current = {};
+	std::atomic<float> lastRenderMilliseconds = 0.0f;
+
+	float hitchMilliseconds;
+	float spikeMilliseconds;
+	uint64_t totalHitchCounts[ChannelCount] = {};
+	size_t framesSinceSpike = capacity;
+
+	//Sorted copy of one channel for the percentiles
+	float sorted[capacity];
+};
@@ -2,421 +2,476 @@
 #include "Player.h"
 #include "CustomObj.h"
 #include "Collectable.h"
-#include <fstream>
+#include "AllocationTracker.h"
+#include "ArchiveMount.h"
+#include "DirectoryMount.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "RenderSystem.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+//The word after an option on the command line, empty if the option is not there
+static std::string GetOption(const std::string& commandLine, const std::string& option)
+{
+	std::istringstream iss(commandLine);
+	std::string word;
+	while (iss >> word)
+	{
+		if (word == option && iss >> word)
+		{
+			return word;
+		}
+	}
+	return std::string();
+}
+
+//Recording and replaying build chunks on the main thread, so a replay collides with the same tiles on the same frames
+static ChunkStreamer::Settings GetStreamerSettings(const std::string& commandLine)
+{
+	ChunkStreamer::Settings settings;
+	settings.synchronous = !GetOption(commandLine, "-record").empty() || !GetOption(commandLine, "-replay").empty();
+	return settings;
+}
 
-Game::Game() : wnd(800, 600, "DirectX 3D Platformer")
+Game::Game(const std::string& commandLine) :
+	wnd(800, 600, "DirectX 3D Platformer"),
+	tileRenderer(wnd.Gfx()),
+	levelLoader(wnd.Gfx(), GetStreamerSettings(commandLine))
 {
+	//The main thread is one of the job threads, it runs jobs while it waits on them
+	JobSystem::Start();
+
+	//Budgets for the largest level we ship, a category over its budget is flagged in the report on every level swap
+	MemoryTracker::SetBudget(MemoryTracker::LevelDataCategory, 16 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::ChunkCategory, 64 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::EntityCategory, 32 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::LevelObjectCategory, 64 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::VertexBufferCategory, 64 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::IndexBufferCategory, 16 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::TextureCategory, 128 * 1024 * 1024);
+	MemoryTracker::SetBudget(MemoryTracker::ConstantBufferCategory, 4 * 1024 * 1024);
+
+	//Loose files next to the executable, overridden by the packed assets when they have been built
+	VirtualFileSystem::Mount("", std::make_unique<DirectoryMount>(""));
+	auto pArchive = std::make_unique<ArchiveMount>("Assets.pak");
+	if (pArchive->IsOpen())
+	{
+		VirtualFileSystem::Mount("", std::move(pArchive));
+	}
+
+	overlay = std::make_unique<PerfOverlay>(wnd.Gfx());
 	player = std::make_unique<Player>(wnd.Gfx(), 0.0f, 0.0f, 0.0f);
 	camera = std::make_unique<Camera>(player.get());
 	colourbox = std::make_unique<Box>(wnd.Gfx(), 0.0f, 0.0f, 0.0f);
 
-	InitialiseLevel(levelNum);
+	const std::string replayPath = GetOption(commandLine, "-replay");
+	if (!replayPath.empty())
+	{
+		replayInput = recording.Load(replayPath);
+		OutputDebugStringA(replayInput ? "Replaying " : "Failed to load the replay ");
+		OutputDebugStringA(replayPath.c_str());
+		OutputDebugStringA("\n");
+		if (replayInput)
+		{
+			levelNum = (std::max)(1, (std::min)(recording.GetStartLevel(), LevelState::levelCount));
+		}
+	}
+	else
+	{
+		recordingPath = GetOption(commandLine, "-record");
+		recordInput = !recordingPath.empty();
+		recording.Start(levelNum);
+	}
+
+	SwapLevel(levelNum);
 
 	//Set projection and camera
 	wnd.Gfx().SetProjection(DirectX::XMMatrixPerspectiveLH(1.0f, 3.0f / 4.0f, 0.5f, 40.0f));
 	wnd.DisableCursor();
+
+	renderThread = std::thread(&Game::RenderLoop, this);
+
+	//The first frame should not count the time spent loading
+	timer.Mark();
 }
 
 Game::~Game()
 {
+	snapshots.Close();
+	renderThread.join();
+
+	if (recordInput)
+	{
+		OutputDebugStringA(recording.Save(recordingPath) ? "Input recorded to " : "Failed to record input to ");
+		OutputDebugStringA(recordingPath.c_str());
+		OutputDebugStringA("\n");
+	}
 }
 
 int Game::Start()
 {
+	PROFILE_THREAD("Main");
+
 	//Message loop
 	while (true)
 	{
-		if (const auto ecode = Window::ProcessMessages())
 		{
-			return *ecode;
+			PROFILE_SCOPE("Messages");
+			if (const auto ecode = Window::ProcessMessages())
+			{
+				return *ecode;
+			}
 		}
 		UpdateFrame();
 	}
 }
 
-void Game::ClearLevel()
-{
-	boxes.clear();
-	bridge.clear();
-	collectables.clear();
-	pressurePlate.reset();
-	goal.reset();
-}
-
-void Game::InitialiseLevel(int level_num)
+//Swap in a level built by the loader, only waiting for it when it is not finished yet
+void Game::SwapLevel(int level_num)
 {
-	ClearLevel();
-
-	std::string levelFileName = "";
-	std::fstream levelFile;
-	levelFileName.append("Resources\\Level" + std::to_string(level_num) + ".txt");
-
-	std::string itemFileName = "";
-	std::fstream itemFile;
-	itemFileName.append("Resources\\Level" + std::to_string(level_num) + "_Items" + ".txt");
-
-	levelFile.open(levelFileName);
-	itemFile.open(itemFileName);
-
-	float levelWidth = 0;
-	float levelHeight = 0;
+	PROFILE_SCOPE("SwapLevel");
+	const auto start = std::chrono::steady_clock::now();
+	const bool preloaded = levelLoader.IsReady(level_num);
 
-	levelFile >> levelWidth;
-	levelFile >> levelHeight;
-
-	float x = 0;
-	float y = 0;
-	float z = 0;
-
-	while (!levelFile.eof())
+	if (level)
 	{
-		float levelValue;
-		float itemValue;
-
-		if (levelFile >> levelValue)
-		{
-			if (itemFile >> itemValue)
-			{
-				if (levelValue != -1.0f)
-				{
-					if (levelValue >= 0)
-					{
-						float levelHeight = levelValue;
-
-						for (int yVal = 0; yVal <= levelHeight; yVal++)
-						{
-							y = yVal;
-							boxes.push_back(std::make_unique<TexturedBox>(wnd.Gfx(), L"platform.png", x, y, z));
-						}
-					}
-					else
-					{
-						y = levelValue * -1;
-						bridge.push_back(std::make_unique<Bridge>(wnd.Gfx(), L"bridge.png", x, y, z));
-					}
-
-					//Player
-					if (itemValue == 2.0f)
-					{
-						float spawnX = x;
-						float spawnY = y + 1;
-						float spawnZ = z;
-						player->SetSpawnPosition(spawnX, spawnY, spawnZ);
-						player->SetPosition(spawnX, spawnY, spawnZ);
-					}
-					//Collectable
-					else if (itemValue == 3.0f)
-					{
-						collectables.push_back(std::make_unique<Collectable>(wnd.Gfx(), L"CHAHIN_BOTTLE_OF_SODA", x, y + 1.5f, z, 0.25f, 0.25f, 0.25f, true, true));
-					}
-					//Trigger
-					else if (itemValue == 4.0)
-					{
-						pressurePlate = std::make_unique<TriggerObj>(wnd.Gfx(), L"BRB", x, y + 0.7f, z, 7.0f, 7.0f, 7.0f);
-					}
-					//Goal
-					else if (itemValue == 5.0f)
-					{
-						goal = std::make_unique<CustomObj>(wnd.Gfx(), L"flag", x + 4.5f, y + 0.5f, z, DirectX::XM_PI, 0.25f, 0.25f, 0.25f, false, false);
-					}
-				}
-			}
-		}
-		else
-		{
-			//error with file loading
-			levelFile.close();
-			itemFile.close();
-			return;
-		}
-
-		//Change position of next object
-		x += 1.0f;
-
-		if (x >= levelWidth)
-		{
-			x = 0.0f;
-			z += 1.0f;
-		}
+		//Snapshots still waiting to be drawn point at the old level's meshes
+		snapshots.WaitUntilIdle();
+		levelLoader.Retire(std::move(level));
+	}
+	level = levelLoader.Take(level_num);
+	simulation.SetLevel(level.get());
+	rewind.Reset(simulation.GetStateSize());
+	rewindState.resize(simulation.GetStateSize());
 
+	//Start building the next level straight away so it is ready by the time the goal is reached
+	if (level_num < LevelState::levelCount)
+	{
+		levelLoader.Request(level_num + 1);
 	}
-	levelFile.close();
-	itemFile.close();
-	return;
+
+	swapMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	levelSwapped = true;
+	allocationCheckFrame = frameNumber + allocationWarmUpFrames;
+
+	const VirtualFileSystem::Stats stats = VirtualFileSystem::GetStats();
+	std::ostringstream oss;
+	oss << "Level " << level_num << (preloaded ? " preloaded" : " not preloaded") << ", swap took " << swapMilliseconds << " ms\n"
+		<< "Files since last swap: " << stats.openCount << " opened, " << stats.failedOpenCount << " failed, "
+		<< stats.bytesRead << " bytes, " << stats.cacheHits << " cache hits, " << stats.cacheMisses << " misses, "
+		<< stats.totalReadMilliseconds << " ms reading\n";
+	OutputDebugStringA(oss.str().c_str());
+	VirtualFileSystem::ResetStats();
+
+	//Both levels are alive at this point, so the peaks include the transition itself
+	OutputDebugStringA(MemoryTracker::GetReport().c_str());
+	MemoryTracker::ResetPeaks();
 }
 
 void Game::UpdateFrame()
 {
+	PROFILE_SCOPE("UpdateFrame");
+	const AllocationScope frameAllocations;
+	const auto frameStart = std::chrono::steady_clock::now();
 	float dt = timer.Mark();
-	wnd.Gfx().ClearBuffer(0.07f, 0.0f, 0.12f, 1.0f);
 
-	//Player movement
-	UpdatePlayer(dt);
-
-	//Goal
-	if (levelNum < 3)
+	//F9 writes the profiler's recent zones for every thread to a trace file
+	const bool traceKeyPressed = wnd.keyboard.KeyIsPressed(VK_F9);
+	if (traceKeyPressed && !traceKeyWasPressed)
 	{
-		DirectX::XMVECTOR aMin = player->GetBBMinVertex();
-		DirectX::XMVECTOR aMax = player->GetBBMaxVertex();
-		DirectX::XMVECTOR bMin = goal->GetBBMinVertex();
-		DirectX::XMVECTOR bMax = goal->GetBBMaxVertex();
-
-		if (CheckCollision(aMin, aMax, bMin, bMax))
-		{
-			levelNum++;
-			InitialiseLevel(levelNum);
-		}
+		OutputDebugStringA(Profiler::WriteChromeTrace("profile.json") ? "Profile written to profile.json\n" : "Failed to write profile.json\n");
 	}
+	traceKeyWasPressed = traceKeyPressed;
 
-	//Trigger
-	if (!pressurePlate->IsActivated())
+	const bool overlayKeyPressed = wnd.keyboard.KeyIsPressed(VK_F10);
+	if (overlayKeyPressed && !overlayKeyWasPressed)
 	{
-		DirectX::XMVECTOR aMin = player->GetBBMinVertex();
-		DirectX::XMVECTOR aMax = player->GetBBMaxVertex();
-		DirectX::XMVECTOR bMin = pressurePlate->GetBBMinVertex();
-		DirectX::XMVECTOR bMax = pressurePlate->GetBBMaxVertex();
+		showOverlay = !showOverlay;
+	}
+	overlayKeyWasPressed = overlayKeyPressed;
 
-		if (CheckCollision(aMin, aMax, bMin, bMax))
+	//Gameplay, from the keyboard or the replay, or a frame back in the level's history while rewinding
+	const InputFrame input = ReadInput(dt);
+	if (!recordInput && !replayInput && wnd.keyboard.KeyIsPressed(0x52))	//R
+	{
+		PROFILE_SCOPE("Rewind");
+		if (rewind.Restore(1, rewindState.data()))
 		{
-			pressurePlate->Activate();
-
-			for (auto& bridgePiece : bridge)
-			{
-				bridgePiece->RaiseBridge(1.0f);
-			}
+			simulation.LoadState(rewindState.data());
+			rewind.Truncate(1);
 		}
 	}
-
-	//Ground collision
-	player->SetGrounded(false);
-
-	for (auto& box : boxes)
+	else
 	{
-		DirectX::XMVECTOR aMin = player->GetBBMinVertex();
-		DirectX::XMVECTOR aMax = player->GetBBMaxVertex();
-		DirectX::XMVECTOR bMin = box->GetBBMinVertex();
-		DirectX::XMVECTOR bMax = box->GetBBMaxVertex();
-
-		if (CheckCollision(aMin, aMax, bMin, bMax))
+		if (simulation.Step(input, frameStats) && levelNum < LevelState::levelCount)
 		{
-			DirectX::XMVECTOR aCenter = player->GetCenterVertex();
-			DirectX::XMVECTOR bCenter = box->GetCenterVertex();
-
-			CollisionResponse(aMin, aMax, bMin, bMax, aCenter, bCenter);
+			levelNum++;
+			SwapLevel(levelNum);
 		}
+		simulation.SaveState(rewindState.data());
+		rewind.Capture(rewindState.data());
 	}
 
-	for (auto& bridgePiece : bridge)
+	//Recordings keep the state every frame ended in, the first replayed frame that ends anywhere else is where the replay diverged
+	if (recordInput)
 	{
-		DirectX::XMVECTOR aMin = player->GetBBMinVertex();
-		DirectX::XMVECTOR aMax = player->GetBBMaxVertex();
-		DirectX::XMVECTOR bMin = bridgePiece->GetBBMinVertex();
-		DirectX::XMVECTOR bMax = bridgePiece->GetBBMaxVertex();
-
-		if (CheckCollision(aMin, aMax, bMin, bMax))
-		{
-			DirectX::XMVECTOR aCenter = player->GetCenterVertex();
-			DirectX::XMVECTOR bCenter = bridgePiece->GetCenterVertex();
+		recording.Add(input, simulation.GetStateHash());
+	}
+	else if (replayInput && recording.HasStateHashes() && !replayDiverged &&
+		simulation.GetStateHash() != recording.GetStateHash(replayFrame - 1))
+	{
+		replayDiverged = true;
+		char message[96];
+		std::snprintf(message, sizeof(message), "Replay diverged from the recording on frame %zu\n", replayFrame - 1);
+		OutputDebugStringA(message);
+	}
 
-			CollisionResponse(aMin, aMax, bMin, bMax, aCenter, bCenter);
-		}
+	//Camera movement
+	{
+		PROFILE_SCOPE("Camera");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::CameraPhase);
+		const Float3& playerPosition = simulation.player.GetPosition();
+		player->SetPosition(playerPosition.x, playerPosition.y, playerPosition.z);
+		player->SetRotation(0.0f, simulation.player.GetRotationY(), 0.0f);
+		UpdateCamera(input);
+		colourbox->Update(dt);
 	}
 
-	//Collectables
-	for (auto& collectable : collectables)
+	PublishSnapshot();
+
+	const float simMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+	if (levelSwapped)
 	{
-		DirectX::XMVECTOR aMin = player->GetBBMinVertex();
-		DirectX::XMVECTOR aMax = player->GetBBMaxVertex();
-		DirectX::XMVECTOR bMin = collectable->GetBBMinVertex();
-		DirectX::XMVECTOR bMax = collectable->GetBBMaxVertex();
+		levelSwapped = false;
+		swapFrameMilliseconds = simMilliseconds;
 
-		if (CheckCollision(aMin, aMax, bMin, bMax))
-		{
-			collectable->SetVisibility(false);
-		}
+		std::ostringstream oss;
+		oss << "Level swap frame took " << swapFrameMilliseconds << " ms\n";
+		OutputDebugStringA(oss.str().c_str());
 	}
-	
-	//Camera movement
-	UpdateCamera(dt);
-	player->Draw(wnd.Gfx());
 
-	for (auto& box : boxes)
+	//A spike keeps the frames leading up to it, so the phase that caused it can be found afterwards
+	const uint64_t allocations = frameAllocations.GetAllocations();
+	UpdatePerfCounters(dt * 1000.0f, simMilliseconds, allocations);
+	if (frameStats.EndFrame(frameNumber, dt * 1000.0f, simMilliseconds, allocations))
 	{
-		box->Update(dt);
-		box->Draw(wnd.Gfx());
+		char path[64];
+		std::snprintf(path, sizeof(path), "frame_spike_%llu.csv", static_cast<unsigned long long>(frameNumber));
+		OutputDebugStringA(frameStats.WriteRecentFrames(path) ? "Frame spike, recent frames written to " : "Frame spike, failed to write ");
+		OutputDebugStringA(path);
+		OutputDebugStringA("\n");
 	}
-
-	for (auto& bridgePiece : bridge)
+	if (frameNumber % FrameStats::capacity == 0)
 	{
-		bridgePiece->Update(dt);
-		bridgePiece->Draw(wnd.Gfx());
+		ReportFrameStats();
 	}
 
-	for (auto& collectable : collectables)
+	//Once warmed up a frame should reuse the memory of the frames before it
+	if (allocations > 0 && frameNumber >= allocationCheckFrame)
 	{
-		collectable->Update(dt);
-		collectable->Draw(wnd.Gfx());
+		ReportFrameAllocations(allocations);
 	}
-
-	pressurePlate->Update(dt);
-	pressurePlate->Draw(wnd.Gfx());
-
-	goal->Update(dt);
-	goal->Draw(wnd.Gfx());
-
-	colourbox->Update(dt);
-	colourbox->Draw(wnd.Gfx());
-	
-	wnd.Gfx().EndFrame();
 }
 
-void Game::UpdatePlayer(float dt)
+void Game::UpdatePerfCounters(float frameMilliseconds, float simMilliseconds, uint64_t allocations)
 {
-	float verticle = 0;
-	float horizontal = 0;
-	float playerRotation = 0;
+	PerfCounters::Add(PerfCounters::AllocationCounter, allocations);
+	PerfCounters::Set(PerfCounters::FrameMillisecondsGauge, frameMilliseconds);
+	PerfCounters::Set(PerfCounters::SimMillisecondsGauge, simMilliseconds);
+	PerfCounters::Set(PerfCounters::EntityGauge, double(level->registry.GetEntityCount()));
+	PerfCounters::Set(PerfCounters::LoadedChunkGauge, double(level->GetChunks().size()));
+	PerfCounters::Set(PerfCounters::CpuBytesGauge, double(MemoryTracker::GetTotalBytes(false)));
+	PerfCounters::Set(PerfCounters::GpuBytesGauge, double(MemoryTracker::GetTotalBytes(true)));
+	PerfCounters::EndFrame();
+}
 
-	if (wnd.keyboard.KeyIsPressed(0x57)) //W
-	{
-		verticle = 1;
-	}
-	if (wnd.keyboard.KeyIsPressed(0x53)) //S
-	{
-		verticle = -1;
-	}
-	if (wnd.keyboard.KeyIsPressed(0x41)) //A
+//The last frame's counters and the frame time percentiles, which are only recalculated twice a second
+void Game::FormatOverlay(char* text, size_t size)
+{
+	if (frameNumber % 30 == 0)
 	{
-		horizontal = -1;
+		overlaySummary = frameStats.GetSummary(FrameStats::FrameChannel);
 	}
-	if (wnd.keyboard.KeyIsPressed(0x44)) //D
+
+	int length = std::snprintf(text, size, "frame %.2f ms  sim %.2f ms  render %.2f ms\np50 %.2f  p95 %.2f  p99 %.2f  max %.2f  hitches %zu\n",
+		PerfCounters::Get(PerfCounters::FrameMillisecondsGauge), PerfCounters::Get(PerfCounters::SimMillisecondsGauge),
+		PerfCounters::Get(PerfCounters::RenderMillisecondsGauge), overlaySummary.p50, overlaySummary.p95, overlaySummary.p99,
+		overlaySummary.max, overlaySummary.hitchCount);
+	for (int counter = 0; counter < PerfCounters::CounterCount && length > 0 && size_t(length) < size; counter++)
 	{
-		horizontal = 1;
+		length += std::snprintf(text + length, size - length, "%s %llu\n", PerfCounters::GetName(PerfCounters::Counter(counter)),
+			static_cast<unsigned long long>(PerfCounters::GetLastFrame(PerfCounters::Counter(counter))));
 	}
-	if (wnd.keyboard.KeyIsPressed(VK_LEFT)) //Q
+	for (int gauge = PerfCounters::EntityGauge; gauge < PerfCounters::GaugeCount && length > 0 && size_t(length) < size; gauge++)
 	{
-		playerRotation = -1;
+		length += std::snprintf(text + length, size - length, "%s %.0f\n", PerfCounters::GetName(PerfCounters::Gauge(gauge)),
+			PerfCounters::Get(PerfCounters::Gauge(gauge)));
 	}
-	if (wnd.keyboard.KeyIsPressed(VK_RIGHT)) //E
+}
+
+//Lists the phases that allocated, found through the frame statistics
+void Game::ReportFrameAllocations(uint64_t allocations)
+{
+	const FrameStats::Frame& frame = frameStats.GetFrame(frameStats.GetFrameCount() - 1);
+
+	char line[256];
+	int length = std::snprintf(line, sizeof(line), "Frame %llu allocated %llu times after warm-up:",
+		static_cast<unsigned long long>(frame.frameNumber), static_cast<unsigned long long>(allocations));
+	for (int phase = 0; phase < FrameStats::PhaseCount && length > 0 && size_t(length) < sizeof(line); phase++)
 	{
-		playerRotation = 1;
+		if (frame.phaseAllocations[phase] > 0)
+		{
+			length += std::snprintf(line + length, sizeof(line) - length, " %s %u", FrameStats::GetPhaseName(FrameStats::Phase(phase)), frame.phaseAllocations[phase]);
+		}
 	}
-	if (wnd.keyboard.KeyIsPressed(VK_SPACE))
+	OutputDebugStringA(line);
+	OutputDebugStringA("\n");
+}
+
+//Formatted into a fixed buffer so reporting does not allocate during the frame
+void Game::ReportFrameStats()
+{
+	const char* channelNames[FrameStats::ChannelCount] = { "frame", "sim", "render" };
+	for (int channel = 0; channel < FrameStats::ChannelCount; channel++)
 	{
-		player->Jump();
+		const FrameStats::Summary summary = frameStats.GetSummary(FrameStats::Channel(channel));
+		char line[256];
+		std::snprintf(line, sizeof(line), "%s ms over %zu frames: mean %.2f, p50 %.2f, p95 %.2f, p99 %.2f, max %.2f, %zu hitches (%llu total)\n",
+			channelNames[channel], summary.frameCount, summary.mean, summary.p50, summary.p95, summary.p99, summary.max,
+			summary.hitchCount, static_cast<unsigned long long>(summary.totalHitchCount));
+		OutputDebugStringA(line);
 	}
-
-	player->SetPlayerInput(horizontal, verticle);
-	player->SetRotationY(playerRotation * dt);
-	player->ApplyGravity(dt);
-	player->Update(dt);
 }
 
-void Game::UpdateCamera(float dt)
+//Copies what is visible this frame for the render thread, the buffer written into is not being read
+void Game::PublishSnapshot()
 {
-	float rMovement = 0;
-
-	if (wnd.keyboard.KeyIsPressed(VK_UP))
+	PROFILE_SCOPE("Publish snapshot");
+	FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::PublishPhase);
+	FrameSnapshot& snapshot = snapshots.GetWriteBuffer();
+	snapshot.frameNumber = ++frameNumber;
+	DirectX::XMStoreFloat4x4(&snapshot.camera, camera->GetMatrix());
+
+	snapshot.tiles.clear();
+	for (LevelChunk* pChunk : level->GetChunks())
 	{
-		rMovement = -5;
+		snapshot.tiles.insert(snapshot.tiles.end(), pChunk->tiles.begin(), pChunk->tiles.end());
 	}
-	if (wnd.keyboard.KeyIsPressed(VK_DOWN))
+
+	snapshot.objects.clear();
+	snapshot.objects.push_back({ player.get(), RenderSystem::ToWorld(player->GetWorldMatrix()) });
+	snapshot.objects.push_back({ colourbox.get(), RenderSystem::ToWorld(colourbox->GetWorldMatrix()) });
+	RenderQueue::Collect(level->registry, snapshot.objects);
+	PerfCounters::Add(PerfCounters::DrawPacketCounter, snapshot.tiles.size() + snapshot.objects.size());
+
+	snapshot.showOverlay = showOverlay;
+	if (showOverlay)
 	{
-		rMovement = 5;
+		FormatOverlay(snapshot.overlayText, sizeof(snapshot.overlayText));
 	}
 
-	camera->SetMovementTransform(rMovement * dt);
-	wnd.Gfx().SetCamera(camera->GetMatrix());
+	snapshots.Publish();
 }
 
-bool Game::CheckCollision(
-	DirectX::XMVECTOR aMin, DirectX::XMVECTOR aMax, 
-	DirectX::XMVECTOR bMin, DirectX::XMVECTOR bMax)
+//Draws each new snapshot, Present blocks this thread on vsync instead of the simulation
+void Game::RenderLoop()
 {
-	return (DirectX::XMVectorGetX(aMin) < DirectX::XMVectorGetX(bMax) && DirectX::XMVectorGetX(aMax) > DirectX::XMVectorGetX(bMin) &&
-		DirectX::XMVectorGetY(aMin) < DirectX::XMVectorGetY(bMax) && DirectX::XMVectorGetY(aMax) > DirectX::XMVectorGetY(bMin) &&
-		DirectX::XMVectorGetZ(aMin) < DirectX::XMVectorGetZ(bMax) && DirectX::XMVectorGetZ(aMax) > DirectX::XMVectorGetZ(bMin));
+	PROFILE_THREAD("Render");
+
+	while (const FrameSnapshot* pSnapshot = snapshots.Acquire())
+	{
+		const auto start = std::chrono::steady_clock::now();
+		RenderFrame(*pSnapshot);
+		const float renderMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+		frameStats.SetRenderMilliseconds(renderMilliseconds);
+		PerfCounters::Set(PerfCounters::RenderMillisecondsGauge, renderMilliseconds);
+		snapshots.Release();
+	}
 }
 
-void Game::CollisionResponse(
-	DirectX::XMVECTOR aMin, DirectX::XMVECTOR aMax,
-	DirectX::XMVECTOR bMin, DirectX::XMVECTOR bMax,
-	DirectX::XMVECTOR aCenter, DirectX::XMVECTOR bCenter)
+void Game::RenderFrame(const FrameSnapshot& snapshot)
 {
-	namespace dx = DirectX;
-
-	float xPositive = dx::XMVectorGetX(bCenter) - dx::XMVectorGetX(aCenter);
-	float xNegative = dx::XMVectorGetX(aCenter) - dx::XMVectorGetX(bCenter);
-
-	float yPositive = dx::XMVectorGetY(bCenter) - dx::XMVectorGetY(aCenter);
-	float yNegative = dx::XMVectorGetY(aCenter) - dx::XMVectorGetY(bCenter);
-
-	float zPositive = dx::XMVectorGetZ(bCenter) - dx::XMVectorGetZ(aCenter);
-	float zNegative = dx::XMVectorGetZ(aCenter) - dx::XMVectorGetZ(bCenter);
-
-	float entryAxis = max(max(max(xPositive, xNegative), max(yPositive, yNegative)), max(zPositive, zNegative));
-
-	//Distance of the intesection of two objects for each axis
-	float xEntryDistance = 0;
-	float yEntryDistance = 0;
-	float zEntryDistance = 0;
+	PROFILE_SCOPE("RenderFrame");
+	Graphics& gfx = wnd.Gfx();
+	gfx.ClearBuffer(0.07f, 0.0f, 0.12f, 1.0f);
+	gfx.SetCamera(DirectX::XMLoadFloat4x4(&snapshot.camera));
 
-	//Determine the entry distance based on 
-	if (xPositive > xNegative)
 	{
-		xEntryDistance = dx::XMVectorGetX(bMin) - dx::XMVectorGetX(aMax);
+		PROFILE_SCOPE("Draw tiles");
+		tileRenderer.Draw(gfx, snapshot.tiles.data(), snapshot.tiles.size());
 	}
-	else
 	{
-		xEntryDistance = dx::XMVectorGetX(bMax) - dx::XMVectorGetX(aMin);
+		PROFILE_SCOPE("Draw objects");
+		RenderSystem::Draw(gfx, snapshot.objects);
 	}
-
-	if (yPositive > yNegative)
+	if (snapshot.showOverlay)
 	{
-		yEntryDistance = dx::XMVectorGetY(bMin) - dx::XMVectorGetY(aMax);
+		PROFILE_SCOPE("Overlay");
+		overlay->Draw(gfx, snapshot.overlayText);
 	}
-	else
 	{
-		yEntryDistance = dx::XMVectorGetY(bMax) - dx::XMVectorGetY(aMin);
+		PROFILE_SCOPE("Present");
+		gfx.EndFrame();
 	}
+}
 
-	if (zPositive > zNegative)
+//The keyboard's state, or the next frame of the replay with the frame time it was recorded with
+InputFrame Game::ReadInput(float dt)
+{
+	if (replayInput)
 	{
-		zEntryDistance = dx::XMVectorGetZ(bMin) - dx::XMVectorGetZ(aMax);
+		if (replayFrame < recording.GetFrameCount())
+		{
+			return recording.GetFrame(replayFrame++);
+		}
+		replayInput = false;
+		OutputDebugStringA("Replay finished, input is back on the keyboard\n");
 	}
-	else 
+
+	static const struct { unsigned char key; InputFrame::Button button; } bindings[] =
 	{
-		zEntryDistance = dx::XMVectorGetZ(bMax) - dx::XMVectorGetZ(aMin);
+		{ 0x57, InputFrame::ForwardButton },	//W
+		{ 0x53, InputFrame::BackButton },		//S
+		{ 0x41, InputFrame::LeftButton },		//A
+		{ 0x44, InputFrame::RightButton },		//D
+		{ VK_LEFT, InputFrame::TurnLeftButton },
+		{ VK_RIGHT, InputFrame::TurnRightButton },
+		{ VK_SPACE, InputFrame::JumpButton },
+		{ VK_UP, InputFrame::CameraInButton },
+		{ VK_DOWN, InputFrame::CameraOutButton }
+	};
+
+	InputFrame input;
+	input.dt = dt;
+	for (const auto& binding : bindings)
+	{
+		if (wnd.keyboard.KeyIsPressed(binding.key))
+		{
+			input.buttons |= binding.button;
+		}
 	}
 
-	float xVel = dx::XMVectorGetX(player->GetVelocity());
-	float yVel = dx::XMVectorGetY(player->GetVelocity());
-	float zVel = dx::XMVectorGetZ(player->GetVelocity());
+	return input;
+}
 
-	if (yPositive == entryAxis || yNegative == entryAxis)
+void Game::UpdateCamera(const InputFrame& input)
+{
+	float rMovement = 0;
+
+	if (input.IsPressed(InputFrame::CameraInButton))
 	{
-		yVel = 0;
-		player->SetGrounded(true);
-		player->MovePosition(0, yEntryDistance, 0);
+		rMovement = -5;
 	}
-
-	float aHeight = DirectX::XMVectorGetY(aMax) - DirectX::XMVectorGetY(aMin);
-
-	//Don't check side collisions on objects beneath the player
-	if (DirectX::XMVectorGetY(aCenter) - (aHeight / 2) < DirectX::XMVectorGetY(bCenter))
+	if (input.IsPressed(InputFrame::CameraOutButton))
 	{
-		if (xPositive == entryAxis || xNegative == entryAxis)
-		{
-			xVel = 0;
-			player->MovePosition(xEntryDistance, 0, 0);
-		}
-
-		if (zPositive == entryAxis || zNegative == entryAxis)
-		{
-			zVel = 0;
-			player->MovePosition(0, 0, zEntryDistance);
-		}
+		rMovement = 5;
 	}
 
-	player->SetVelocity(xVel, yVel, zVel);
+	camera->SetMovementTransform(rMovement * input.dt);
 }
-
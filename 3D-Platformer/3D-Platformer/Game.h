@@ -7,34 +7,89 @@
 #include "Bridge.h"
 #include "Trigger.h"
 #include "TriggerObj.h"
+#include "LevelLoader.h"
+#include "FrameSnapshot.h"
+#include "FrameStats.h"
+#include "InputRecording.h"
+#include "PerfOverlay.h"
+#include "RewindBuffer.h"
+#include "Simulation.h"
+#include "SnapshotMailbox.h"
+#include "TileRenderer.h"
+#include <atomic>
+#include <string>
+#include <thread>
 
 class Game
 {
 public:
-	Game();
+	//-record <file> saves the session's input when the game closes, -replay <file> plays one back before handing over to the keyboard
+	Game(const std::string& commandLine);
 	~Game();
 	int Start();
 private:
 	void UpdateFrame();
-	void UpdateCamera(float dt);
-	bool CheckCollision(DirectX::XMVECTOR aMin, DirectX::XMVECTOR aMax, DirectX::XMVECTOR bMin, DirectX::XMVECTOR bMax);
-	void CollisionResponse(DirectX::XMVECTOR aMin, DirectX::XMVECTOR aMax, DirectX::XMVECTOR bMin, DirectX::XMVECTOR bMax, DirectX::XMVECTOR aCenter, DirectX::XMVECTOR bCenter);
-	void UpdatePlayer(float dt);
-	void InitialiseLevel(int level_num);
-	void ClearLevel();
+	InputFrame ReadInput(float dt);
+	void PublishSnapshot();
+	void RenderLoop();
+	void RenderFrame(const FrameSnapshot& snapshot);
+	void UpdateCamera(const InputFrame& input);
+	void SwapLevel(int level_num);
+	void ReportFrameStats();
+	void ReportFrameAllocations(uint64_t allocations);
+	void UpdatePerfCounters(float frameMilliseconds, float simMilliseconds, uint64_t allocations);
+	void FormatOverlay(char* text, size_t size);
 private:
 	Window wnd;
 	Timer timer;
 
 	int levelNum = 1;
 
-	std::vector<std::unique_ptr<class TexturedBox>> boxes;
-	std::vector<std::unique_ptr<class Bridge>> bridge;
-	std::vector<std::unique_ptr<class Collectable>> collectables;
-	std::unique_ptr<class TriggerObj> pressurePlate;
-	std::unique_ptr<class CustomObj> goal;
+	TileRenderer tileRenderer;
+	LevelLoader levelLoader;
+	std::unique_ptr<Level> level;
+	Simulation simulation;
+
+	//Input is recorded from the keyboard or replayed from a recording, never both
+	InputRecording recording;
+	std::string recordingPath;
+	bool recordInput = false;
+	bool replayInput = false;
+	size_t replayFrame = 0;
+	bool replayDiverged = false;
+
+	//Holding R steps back through the last minutes of the level instead of simulating, except while recording or replaying
+	RewindBuffer rewind;
+	std::vector<uint8_t> rewindState;
+
+	//Time of the last frame that swapped levels, and of the swap itself
+	bool levelSwapped = false;
+	float swapMilliseconds = 0.0f;
+	float swapFrameMilliseconds = 0.0f;
+
+	//The player's mesh, moved to the simulated player every frame
 	std::unique_ptr<class Player> player;
 	std::unique_ptr<class Camera> camera;
 
 	std::unique_ptr<class Box> colourbox;
+
+	//The main thread pumps messages and simulates, the render thread draws the newest snapshot and waits on vsync
+	SnapshotMailbox<FrameSnapshot> snapshots;
+	uint64_t frameNumber = 0;
+	std::thread renderThread;
+
+	bool traceKeyWasPressed = false;
+
+	//F10 shows the counters and frame times, drawn by the render thread from the text in each snapshot
+	std::unique_ptr<PerfOverlay> overlay;
+	bool showOverlay = false;
+	bool overlayKeyWasPressed = false;
+	FrameStats::Summary overlaySummary = {};
+
+	//Shared with the render thread, which only sets its render time
+	FrameStats frameStats;
+
+	//Frames after a level swap settle their buffers' capacity, after that a frame that allocates is reported
+	static constexpr uint64_t allocationWarmUpFrames = 120;
+	uint64_t allocationCheckFrame = allocationWarmUpFrames;
 };
\ No newline at end of file
@@ -1,10 +1,20 @@
 #include "GameObject.h"
 #include "IndexBuffer.h"
+#include "PerfCounters.h"
 #include <string>
 #include <iostream>
 
 void GameObject::Draw(Graphics& gfx) const noexcept
 {
+	Draw(gfx, GetWorldMatrix());
+}
+
+//Draws the mesh with a world matrix given by the caller, leaving the object itself untouched
+//Used for meshes shared by many entities, and by the render thread for objects the simulation is still moving
+void GameObject::Draw(Graphics& gfx, DirectX::FXMMATRIX world) const noexcept
+{
+	gfx.SetWorld(world);
+
 	//Loop through the bindables and bind them to the pipeline
 	for (auto& bindable : binds)
 	{
@@ -14,6 +24,7 @@ void GameObject::Draw(Graphics& gfx) const noexcept
 	{
 		staticBindable->Bind(gfx);
 	}
+	PerfCounters::Add(PerfCounters::BindCounter, binds.size() + GetStaticBinds().size());
 
 	//Draw object
 	if (isVisible)
@@ -115,6 +126,31 @@ void GameObject::CalculateAABB(DirectX::XMMATRIX transformMatrix)
 	bbMaxVertex = DirectX::XMVectorSet(maxVertex.x, maxVertex.y, maxVertex.z, 0.0f);
 }
 
+void GameObject::MarkTransformDirty() noexcept
+{
+	transformDirty = true;
+	boundsDirty = true;
+}
+
+DirectX::XMMATRIX GameObject::GetWorldMatrix() const noexcept
+{
+	if (transformDirty)
+	{
+		DirectX::XMStoreFloat4x4(&worldMatrix, GetTransformXM());
+		transformDirty = false;
+	}
+	return DirectX::XMLoadFloat4x4(&worldMatrix);
+}
+
+void GameObject::UpdateBounds()
+{
+	if (boundsDirty)
+	{
+		CalculateAABB(GetWorldMatrix());
+		boundsDirty = false;
+	}
+}
+
 DirectX::XMVECTOR GameObject::GetPosition()
 {
 	return DirectX::XMVectorSet(xPos, yPos, zPos, 0.0f);
@@ -122,24 +158,49 @@ DirectX::XMVECTOR GameObject::GetPosition()
 
 DirectX::XMVECTOR GameObject::GetBBMinVertex()
 {
+	UpdateBounds();
 	return bbMinVertex;
 }
 
 DirectX::XMVECTOR GameObject::GetBBMaxVertex()
 {
+	UpdateBounds();
 	return bbMaxVertex;
 }
 
 DirectX::XMVECTOR GameObject::GetCenterVertex()
 {
+	UpdateBounds();
 	return centerVertex;
 }
 
+//Box around the mesh before the transform, the first and seventh bounding box vertices are its corners
+void GameObject::GetModelBounds(DirectX::XMFLOAT3& minVertex, DirectX::XMFLOAT3& maxVertex) const noexcept
+{
+	if (bbVertices.empty())
+	{
+		minVertex = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		maxVertex = DirectX::XMFLOAT3(0.0f, 0.0f, 0.0f);
+		return;
+	}
+	minVertex = bbVertices[0];
+	maxVertex = bbVertices[6];
+}
+
 void GameObject::SetPosition(float _x, float _y, float _z)
 {
 	xPos = _x;
 	yPos = _y;
 	zPos = _z;
+	MarkTransformDirty();
+}
+
+void GameObject::SetRotation(float _x, float _y, float _z)
+{
+	xRot = _x;
+	yRot = _y;
+	zRot = _z;
+	MarkTransformDirty();
 }
 
 void GameObject::SetVisibility(bool _isVisible)
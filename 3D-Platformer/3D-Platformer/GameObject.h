@@ -12,13 +12,17 @@ public:
 	GameObject(const GameObject&) = delete;
 
 	virtual DirectX::XMMATRIX GetTransformXM() const noexcept = 0;
+	DirectX::XMMATRIX GetWorldMatrix() const noexcept;
 	DirectX::XMVECTOR GetPosition();
 	DirectX::XMVECTOR GetBBMinVertex();
 	DirectX::XMVECTOR GetBBMaxVertex();
 	DirectX::XMVECTOR GetCenterVertex();
+	void GetModelBounds(DirectX::XMFLOAT3& minVertex, DirectX::XMFLOAT3& maxVertex) const noexcept;
 	void SetPosition(float _x, float _y, float _z);
+	void SetRotation(float _x, float _y, float _z);
 	void SetVisibility(bool _isVisible);
 	void Draw(Graphics& gfx) const noexcept;
+	void Draw(Graphics& gfx, DirectX::FXMMATRIX world) const noexcept;
 	virtual void Update(float dt) noexcept = 0;
 	virtual ~GameObject() = default;
 
@@ -27,6 +31,8 @@ protected:
 	void AddIndexBuffer(std::unique_ptr<class IndexBuffer> ibuf);
 	void CreateBoundingBox(std::vector<DirectX::XMFLOAT3>& verticesPositions);
 	void CalculateAABB(DirectX::XMMATRIX transformMatrix);
+	//Call after changing the position, rotation or scale, the world matrix and bounding box are rebuilt the next time they are used
+	void MarkTransformDirty() noexcept;
 
 	//Model transform
 	DirectX::XMFLOAT3X3 modelTransform;
@@ -48,6 +54,14 @@ private:
 	virtual const std::vector<std::unique_ptr<Bindable>>& GetStaticBinds() const noexcept = 0;
 
 private:
+	void UpdateBounds();
+
+private:
+	//World matrix and bounding box cached from the transform until it changes
+	mutable DirectX::XMFLOAT4X4 worldMatrix;
+	mutable bool transformDirty = true;
+	bool boundsDirty = true;
+
 	const IndexBuffer* pIndexBuffer = nullptr;
 	std::vector<std::unique_ptr<Bindable>> binds;
 
@@ -1,4 +1,5 @@
 #include "Graphics.h"
+#include "PerfCounters.h"
 #include <sstream>
 #include <DirectXMath.h>
 
@@ -57,10 +58,9 @@ Graphics::Graphics(HWND hWnd)
 	depthStencilDesc.DepthEnable = TRUE;
 	depthStencilDesc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
 	depthStencilDesc.DepthFunc = D3D11_COMPARISON_LESS;
-	ID3D11DepthStencilState* pDSState;
-	pDevice->CreateDepthStencilState(&depthStencilDesc, &pDSState);
+	pDevice->CreateDepthStencilState(&depthStencilDesc, &pDepthStencilState);
 
-	pContext->OMSetDepthStencilState(pDSState, 1u);
+	pContext->OMSetDepthStencilState(pDepthStencilState, 1u);
 
 	//Create depth stensil texture
 	ID3D11Texture2D* pDepthStencil;
@@ -98,7 +98,6 @@ Graphics::Graphics(HWND hWnd)
 
 	pContext->RSSetViewports(1u, &viewport);
 
-	pDSState->Release();
 	pDepthStencil->Release();
 }
 
@@ -126,6 +125,10 @@ Graphics::~Graphics()
 	{
 		pDepthStencilView->Release();
 	}
+	if (pDepthStencilState != nullptr)
+	{
+		pDepthStencilState->Release();
+	}
 }
 
 void Graphics::EndFrame()
@@ -143,6 +146,15 @@ void Graphics::ClearBuffer(float r, float g, float b, float a)
 void Graphics::DrawIndexed(UINT count)
 {
 	pContext->DrawIndexed(count, 0u, 0u);
+	PerfCounters::Add(PerfCounters::DrawCallCounter);
+	PerfCounters::Add(PerfCounters::TriangleCounter, count / 3u);
+}
+
+void Graphics::RestoreState()
+{
+	pContext->OMSetDepthStencilState(pDepthStencilState, 1u);
+	pContext->OMSetBlendState(nullptr, nullptr, 0xffffffffu);
+	pContext->RSSetState(nullptr);
 }
 
 //Projection matrix
@@ -166,3 +178,14 @@ DirectX::XMMATRIX Graphics::GetCamera() const
 {
 	return camera;
 }
+
+//World matrix of the object being drawn
+void Graphics::SetWorld(DirectX::FXMMATRIX _world)
+{
+	world = _world;
+}
+
+DirectX::XMMATRIX Graphics::GetWorld() const
+{
+	return world;
+}
@@ -9,19 +9,26 @@
 class Graphics
 {
 	friend class Bindable;
+	friend class PerfOverlay;
 public:
 	Graphics(HWND hWnd);
 	~Graphics();
 	void EndFrame();
 	void ClearBuffer(float r, float g, float b, float a);
 	void DrawIndexed(UINT count);
+	//Puts back the states the scene is drawn with, after something like SpriteBatch has changed them
+	void RestoreState();
 	void SetProjection(DirectX::FXMMATRIX _projection);
 	DirectX::XMMATRIX GetProjection() const;
 	void SetCamera(DirectX::FXMMATRIX _camera);
 	DirectX::XMMATRIX GetCamera() const;
+	void SetWorld(DirectX::FXMMATRIX _world);
+	DirectX::XMMATRIX GetWorld() const;
 private:
 	DirectX::XMMATRIX projection;
 	DirectX::XMMATRIX camera;
+	//World matrix of the object being drawn
+	DirectX::XMMATRIX world;
 	
 	//COM objects
 	ID3D11Device* pDevice = nullptr;
@@ -29,4 +36,5 @@ private:
 	ID3D11DeviceContext* pContext = nullptr;
 	ID3D11RenderTargetView* pRenderTargetView = nullptr;
 	ID3D11DepthStencilView* pDepthStencilView = nullptr;
+	ID3D11DepthStencilState* pDepthStencilState = nullptr;
 };
\ No newline at end of file
@@ -13,6 +13,12 @@ IndexBuffer::IndexBuffer(Graphics& gfx, const std::vector<unsigned short>& indic
 	D3D11_SUBRESOURCE_DATA indexBufferData = {};										//Clear the memory in the index buffer
 	indexBufferData.pSysMem = indices.data();											//The data to place into the buffer	
 	GetDevice(gfx)->CreateBuffer(&indexBufferDesc, &indexBufferData, &pIndexBuffer);	//Create the buffer	
+
+	if (pIndexBuffer != nullptr)
+	{
+		byteSize = indexBufferDesc.ByteWidth;
+		MemoryTracker::Add(MemoryTracker::IndexBufferCategory, byteSize);
+	}
 }
 
 IndexBuffer::~IndexBuffer()
@@ -20,6 +26,7 @@ IndexBuffer::~IndexBuffer()
 	if (pIndexBuffer != nullptr)
 	{
 		pIndexBuffer->Release();
+		MemoryTracker::Remove(MemoryTracker::IndexBufferCategory, byteSize);
 	}
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Bindable.h"
+#include "MemoryTracker.h"
 
 class IndexBuffer : public Bindable
 {
@@ -10,5 +11,6 @@ public:
 	UINT GetCount() const noexcept;
 protected:
 	UINT count;
+	UINT byteSize = 0u;
 	ID3D11Buffer* pIndexBuffer = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "InputRecording.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+static constexpr size_t inputBytes = sizeof(float) + sizeof(uint16_t);
+static constexpr size_t frameBytes = inputBytes + sizeof(uint64_t);
+
+bool InputFrame::IsPressed(Button button) const noexcept
+{
+	return (buttons & button) != 0;
+}
+
+//Room for ten minutes at 60 frames a second is reserved up front, so recording does not show up as frames that allocate
+void InputRecording::Start(int _startLevel)
+{
+	startLevel = _startLevel;
+	frames.clear();
+	frames.reserve(60 * 60 * 10);
+	stateHashes.clear();
+	stateHashes.reserve(60 * 60 * 10);
+}
+
+void InputRecording::Add(const InputFrame& frame, uint64_t stateHash)
+{
+	frames.push_back(frame);
+	stateHashes.push_back(stateHash);
+}
+
+int InputRecording::GetStartLevel() const noexcept
+{
+	return startLevel;
+}
+
+size_t InputRecording::GetFrameCount() const noexcept
+{
+	return frames.size();
+}
+
+const InputFrame& InputRecording::GetFrame(size_t index) const noexcept
+{
+	return frames[index];
+}
+
+bool InputRecording::HasStateHashes() const noexcept
+{
+	return !stateHashes.empty() && stateHashes.size() == frames.size();
+}
+
+uint64_t InputRecording::GetStateHash(size_t index) const noexcept
+{
+	return stateHashes[index];
+}
+
+bool InputRecording::Save(const std::string& path) const
+{
+	Header header = {};
+	memcpy(header.magic, "INP1", 4);
+	header.version = version;
+	header.startLevel = uint32_t(startLevel);
+	header.frameCount = uint32_t(frames.size());
+
+	std::vector<char> data(sizeof(Header) + frames.size() * frameBytes);
+	memcpy(data.data(), &header, sizeof(Header));
+	char* pFrame = data.data() + sizeof(Header);
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		const uint64_t stateHash = HasStateHashes() ? stateHashes[i] : 0;
+		memcpy(pFrame, &frames[i].dt, sizeof(float));
+		memcpy(pFrame + sizeof(float), &frames[i].buttons, sizeof(uint16_t));
+		memcpy(pFrame + inputBytes, &stateHash, sizeof(uint64_t));
+		pFrame += frameBytes;
+	}
+
+	std::ofstream fileOut(path, std::ios::binary);
+	return fileOut.write(data.data(), data.size()) && fileOut.flush();
+}
+
+bool InputRecording::Load(const std::string& path)
+{
+	std::ifstream fileIn(path, std::ios::binary);
+	const std::vector<char> data((std::istreambuf_iterator<char>(fileIn)), std::istreambuf_iterator<char>());
+	if (data.size() < sizeof(Header))
+	{
+		return false;
+	}
+
+	Header header;
+	memcpy(&header, data.data(), sizeof(Header));
+	const bool hashed = header.version == version;
+	const size_t fileFrameBytes = hashed ? frameBytes : inputBytes;
+	if (memcmp(header.magic, "INP1", 4) != 0 || (header.version != 1 && !hashed) ||
+		uint64_t(header.frameCount) * fileFrameBytes != data.size() - sizeof(Header))
+	{
+		return false;
+	}
+
+	startLevel = int(header.startLevel);
+	frames.resize(header.frameCount);
+	stateHashes.resize(hashed ? header.frameCount : 0);
+	const char* pFrame = data.data() + sizeof(Header);
+	for (size_t i = 0; i < frames.size(); i++)
+	{
+		memcpy(&frames[i].dt, pFrame, sizeof(float));
+		memcpy(&frames[i].buttons, pFrame + sizeof(float), sizeof(uint16_t));
+		if (hashed)
+		{
+			memcpy(&stateHashes[i], pFrame + inputBytes, sizeof(uint64_t));
+		}
+		pFrame += fileFrameBytes;
+	}
+	return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//What the simulation reads from the player in one frame, and how long the frame was
+struct InputFrame
+{
+	enum Button : uint16_t
+	{
+		ForwardButton = 1u << 0,
+		BackButton = 1u << 1,
+		LeftButton = 1u << 2,
+		RightButton = 1u << 3,
+		TurnLeftButton = 1u << 4,
+		TurnRightButton = 1u << 5,
+		JumpButton = 1u << 6,
+		CameraInButton = 1u << 7,
+		CameraOutButton = 1u << 8
+	};
+
+	float dt = 0.0f;
+	uint16_t buttons = 0;
+
+	bool IsPressed(Button button) const noexcept;
+};
+
+//Every frame of a play session from the level it started on, replaying it steps the simulation through the same states
+//File layout: Header | Frames, each the frame time, the buttons and the simulation's state hash after it packed into 14 bytes
+//Version 1 files have no hashes and 6 byte frames, they still replay but cannot be checked for divergence
+class InputRecording
+{
+public:
+	static constexpr uint32_t version = 2;
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t startLevel;
+		uint32_t frameCount;
+	};
+public:
+	void Start(int _startLevel);
+	void Add(const InputFrame& frame, uint64_t stateHash);
+	int GetStartLevel() const noexcept;
+	size_t GetFrameCount() const noexcept;
+	const InputFrame& GetFrame(size_t index) const noexcept;
+	bool HasStateHashes() const noexcept;
+	uint64_t GetStateHash(size_t index) const noexcept;
+
+	bool Save(const std::string& path) const;
+	bool Load(const std::string& path);
+private:
+	int startLevel = 1;
+	std::vector<InputFrame> frames;
+	//Empty when loaded from a version 1 file
+	std::vector<uint64_t> stateHashes;
+};
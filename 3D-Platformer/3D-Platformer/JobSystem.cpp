@@ -0,0 +1,332 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+JobSystem JobSystem::jobSystem;
+
+//Index of the calling thread's queue, the thread that called Start is 0
+static constexpr size_t noQueue = ~size_t(0);
+static thread_local size_t threadQueue = noQueue;
+//Whether the job the calling thread is running is a background job
+static thread_local bool runningBackground = false;
+
+bool JobCounter::IsDone() const noexcept
+{
+	return count.load(std::memory_order_acquire) == 0;
+}
+
+bool JobSystem::WorkerQueue::Push(const Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (tail - head == capacity)
+	{
+		return false;
+	}
+	jobs[tail % capacity] = job;
+	tail++;
+	return true;
+}
+
+bool JobSystem::WorkerQueue::Pop(Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (tail == head)
+	{
+		return false;
+	}
+	tail--;
+	job = jobs[tail % capacity];
+	return true;
+}
+
+bool JobSystem::WorkerQueue::Steal(Job& job)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (tail == head)
+	{
+		return false;
+	}
+	job = jobs[head % capacity];
+	head++;
+	return true;
+}
+
+JobSystem::~JobSystem()
+{
+	Stop();
+}
+
+void JobSystem::Start(size_t threadCount)
+{
+	Stop();
+
+	if (threadCount == 0)
+	{
+		threadCount = (std::max)(std::thread::hardware_concurrency(), 1u);
+	}
+
+	jobSystem.stopping = false;
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		jobSystem.queues.push_back(std::make_unique<WorkerQueue>());
+	}
+	jobSystem.pBackgroundQueue = std::make_unique<WorkerQueue>();
+
+	threadQueue = 0;
+	for (size_t i = 1; i < threadCount; i++)
+	{
+		jobSystem.workers.emplace_back(&JobSystem::WorkerLoop, &jobSystem, i);
+	}
+}
+
+//Jobs still queued are finished before the workers exit
+void JobSystem::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(jobSystem.sleepMutex);
+		jobSystem.stopping = true;
+	}
+	jobSystem.sleepCondition.notify_all();
+
+	for (std::thread& worker : jobSystem.workers)
+	{
+		worker.join();
+	}
+	jobSystem.workers.clear();
+
+	Job job;
+	while (jobSystem.Take(job, true))
+	{
+		jobSystem.Execute(job);
+	}
+	jobSystem.queues.clear();
+	jobSystem.pBackgroundQueue.reset();
+	threadQueue = noQueue;
+}
+
+size_t JobSystem::GetThreadCount() noexcept
+{
+	return (std::max)(jobSystem.queues.size(), size_t(1));
+}
+
+void JobSystem::Run(const Job& job, JobCounter* pCounter, JobCounter* pDependency)
+{
+	Job counted = job;
+	counted.pCounter = pCounter;
+	counted.background = threadQueue == noQueue || runningBackground;
+	if (pCounter != nullptr)
+	{
+		pCounter->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//Checked under the dependency's lock, so it cannot reach zero between the check and the job being added
+	if (pDependency != nullptr)
+	{
+		std::lock_guard<std::mutex> lock(pDependency->continuationMutex);
+		if (!pDependency->IsDone())
+		{
+			pDependency->continuations.push_back(counted);
+			return;
+		}
+	}
+	jobSystem.Push(counted);
+}
+
+void JobSystem::Run(std::function<void()> function, JobCounter* pCounter, JobCounter* pDependency)
+{
+	Job job;
+	job.pFunction = [](void* pData, size_t, size_t)
+	{
+		std::unique_ptr<std::function<void()>> pFunction(static_cast<std::function<void()>*>(pData));
+		(*pFunction)();
+	};
+	job.pData = new std::function<void()>(std::move(function));
+	Run(job, pCounter, pDependency);
+}
+
+void JobSystem::Wait(JobCounter& counter)
+{
+	const bool takeBackground = threadQueue != 0;
+	Job job;
+	while (!counter.IsDone())
+	{
+		if (jobSystem.Take(job, takeBackground))
+		{
+			jobSystem.Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(jobSystem.sleepMutex);
+		jobSystem.waitCondition.wait(lock, [&counter, takeBackground]()
+		{
+			const size_t takeable = takeBackground ? jobSystem.queuedCount.load() : jobSystem.queuedCount - jobSystem.backgroundQueuedCount;
+			return counter.IsDone() || takeable > 0;
+		});
+	}
+
+	//The last job may still hold the lock after counting down, and the counter must not be destroyed under it
+	std::lock_guard<std::mutex> lock(counter.continuationMutex);
+}
+
+JobSystem::Stats JobSystem::GetStats() noexcept
+{
+	Stats stats;
+	stats.jobsRun = jobSystem.jobsRun;
+	stats.jobsStolen = jobSystem.jobsStolen;
+	stats.jobsRunInline = jobSystem.jobsRunInline;
+	return stats;
+}
+
+void JobSystem::ResetStats() noexcept
+{
+	jobSystem.jobsRun = 0;
+	jobSystem.jobsStolen = 0;
+	jobSystem.jobsRunInline = 0;
+}
+
+//Without worker threads, or when the queue is full, the job runs straight away on the calling thread
+void JobSystem::Push(const Job& job)
+{
+	if (workers.empty())
+	{
+		jobsRunInline++;
+		Execute(job);
+		return;
+	}
+
+	//A thread without a queue of its own can still push a frame job when it finishes one that others depend on, it goes to a worker
+	WorkerQueue& queue = job.background ? *pBackgroundQueue :
+		*queues[threadQueue != noQueue ? threadQueue : 1 + nextQueue++ % workers.size()];
+	queuedCount++;
+	if (job.background)
+	{
+		backgroundQueuedCount++;
+	}
+	if (!queue.Push(job))
+	{
+		if (job.background)
+		{
+			backgroundQueuedCount--;
+		}
+		queuedCount--;
+		jobsRunInline++;
+		Execute(job);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	sleepCondition.notify_one();
+	waitCondition.notify_all();
+}
+
+//Frame jobs come first, background jobs are only taken once every other queue is empty
+bool JobSystem::Take(Job& job, bool takeBackground)
+{
+	if (queues.empty())
+	{
+		return false;
+	}
+
+	if (threadQueue != noQueue && queues[threadQueue]->Pop(job))
+	{
+		queuedCount--;
+		return true;
+	}
+
+	const size_t start = threadQueue != noQueue ? threadQueue + 1 : 0;
+	for (size_t i = 0; i < queues.size(); i++)
+	{
+		const size_t index = (start + i) % queues.size();
+		if (index != threadQueue && queues[index]->Steal(job))
+		{
+			queuedCount--;
+			jobsStolen++;
+			return true;
+		}
+	}
+
+	if (takeBackground && pBackgroundQueue->Steal(job))
+	{
+		backgroundQueuedCount--;
+		queuedCount--;
+		return true;
+	}
+	return false;
+}
+
+void JobSystem::Execute(const Job& job)
+{
+	const bool wasRunningBackground = runningBackground;
+	runningBackground = job.background;
+	job.pFunction(job.pData, job.begin, job.end);
+	runningBackground = wasRunningBackground;
+	jobsRun++;
+
+	if (job.pCounter != nullptr)
+	{
+		Finish(*job.pCounter);
+	}
+}
+
+//Queues the jobs that were waiting on the counter once its last job is done
+//The counter is not touched after the lock is released, as a waiting thread may destroy it from then on
+void JobSystem::Finish(JobCounter& counter)
+{
+	std::vector<Job> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter.continuationMutex);
+		if (counter.count.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+		continuations.swap(counter.continuations);
+	}
+
+	//Taking the lock means a thread that found the counter unfinished is already asleep and gets woken
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+	}
+	waitCondition.notify_all();
+
+	for (const Job& continuation : continuations)
+	{
+		Push(continuation);
+	}
+}
+
+void JobSystem::WorkerLoop(size_t index)
+{
+	PROFILE_THREAD("Job worker");
+	threadQueue = index;
+
+#ifdef _WIN32
+	//Asset jobs decode textures through WIC, which needs COM on this thread
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+
+	Job job;
+	while (true)
+	{
+		if (Take(job, true))
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepCondition.wait(lock, [this]() { return stopping || queuedCount > 0; });
+		if (stopping && queuedCount == 0)
+		{
+			break;
+		}
+	}
+
+#ifdef _WIN32
+	CoUninitialize();
+#endif
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+//A function called with a range, so a parallel for can hand each job a slice of the objects without allocating
+struct Job
+{
+	void (*pFunction)(void* pData, size_t begin, size_t end) = nullptr;
+	void* pData = nullptr;
+	size_t begin = 0;
+	size_t end = 0;
+	JobCounter* pCounter = nullptr;
+	//Set by Run for work started off the frame, see JobSystem
+	bool background = false;
+};
+
+//Counts the unfinished jobs it was given to, and holds back jobs that depend on it until it reaches zero
+//A counter has to outlive its jobs and can only be reused once it has been waited on
+class JobCounter
+{
+	friend class JobSystem;
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	bool IsDone() const noexcept;
+private:
+	std::atomic<size_t> count = 0;
+	std::mutex continuationMutex;
+	std::vector<Job> continuations;
+};
+
+//Work stealing scheduler shared by the whole game
+//Every thread has its own queue, it takes its newest job first and steals the oldest job from another queue when it runs out
+//The thread that calls Start counts as one of the threads and runs jobs whenever it waits on a counter
+//Jobs run from a thread without a queue, such as the level loader, and every job they start are background jobs
+//Background jobs share one queue that the workers take from once the frame's queues are empty and that the thread which called Start never takes from, so a wait during the frame cannot end up building a level
+class JobSystem
+{
+public:
+	struct Stats
+	{
+		uint64_t jobsRun;
+		uint64_t jobsStolen;
+		uint64_t jobsRunInline;
+	};
+public:
+	//threadCount includes the calling thread, 0 uses every hardware thread
+	static void Start(size_t threadCount = 0);
+	static void Stop();
+	static size_t GetThreadCount() noexcept;
+
+	//Queues a job, counted by pCounter if given, and held back until pDependency reaches zero if given
+	static void Run(const Job& job, JobCounter* pCounter = nullptr, JobCounter* pDependency = nullptr);
+	//Fire and forget work such as asset loading, or one step of a larger task, the function is copied to the heap
+	static void Run(std::function<void()> function, JobCounter* pCounter = nullptr, JobCounter* pDependency = nullptr);
+	//Runs queued jobs on the calling thread until the counter reaches zero, and sleeps while there are none it may take
+	static void Wait(JobCounter& counter);
+
+	//Calls body(begin, end) for slices of [0, count) batchSize long across every thread and returns when all are done
+	template<typename Body>
+	static void ParallelFor(size_t count, size_t batchSize, const Body& body);
+
+	static Stats GetStats() noexcept;
+	static void ResetStats() noexcept;
+private:
+	//Fixed size ring, the owner pushes and pops at the back while other threads steal from the front
+	class WorkerQueue
+	{
+	public:
+		bool Push(const Job& job);
+		bool Pop(Job& job);
+		bool Steal(Job& job);
+	private:
+		static constexpr size_t capacity = 4096;
+		std::mutex mutex;
+		Job jobs[capacity];
+		size_t head = 0;
+		size_t tail = 0;
+	};
+private:
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+	void Push(const Job& job);
+	bool Take(Job& job, bool takeBackground);
+	void Execute(const Job& job);
+	void Finish(JobCounter& counter);
+	void WorkerLoop(size_t index);
+private:
+	static JobSystem jobSystem;													//Job system singleton
+
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::unique_ptr<WorkerQueue> pBackgroundQueue;
+	std::vector<std::thread> workers;
+	std::atomic<size_t> nextQueue = 0;
+
+	//Idle workers sleep until a job is queued, and waiting threads until one they may take is queued or a counter reaches zero
+	std::atomic<size_t> queuedCount = 0;
+	std::atomic<size_t> backgroundQueuedCount = 0;
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::condition_variable waitCondition;
+	bool stopping = false;
+
+	std::atomic<uint64_t> jobsRun = 0;
+	std::atomic<uint64_t> jobsStolen = 0;
+	std::atomic<uint64_t> jobsRunInline = 0;
+};
+
+template<typename Body>
+void JobSystem::ParallelFor(size_t count, size_t batchSize, const Body& body)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	Job job;
+	job.pFunction = [](void* pData, size_t begin, size_t end) { (*static_cast<const Body*>(pData))(begin, end); };
+	job.pData = const_cast<Body*>(&body);
+
+	JobCounter counter;
+	batchSize = (std::max)(batchSize, size_t(1));
+	for (size_t begin = 0; begin < count; begin += batchSize)
+	{
+		job.begin = begin;
+		job.end = (std::min)(begin + batchSize, count);
+		Run(job, &counter);
+	}
+	Wait(counter);
+}
@@ -7,10 +7,11 @@ bool Keyboard::KeyIsPressed( unsigned char keycode ) const noexcept
 
 Keyboard::Event Keyboard::ReadKey() noexcept
 {
-	if( keybuffer.size() > 0u )
+	if( keybufferCount > 0u )
 	{
-		Keyboard::Event e = keybuffer.front();
-		keybuffer.pop();
+		Keyboard::Event e = keybuffer[keybufferStart];
+		keybufferStart = (keybufferStart + 1u) % bufferSize;
+		keybufferCount--;
 		return e;
 	}
 	else
@@ -21,12 +22,13 @@ Keyboard::Event Keyboard::ReadKey() noexcept
 
 bool Keyboard::KeyIsEmpty() const noexcept
 {
-	return keybuffer.empty();
+	return keybufferCount == 0u;
 }
 
 void Keyboard::ClearKey() noexcept
 {
-	keybuffer = std::queue<Event>();
+	keybufferStart = 0u;
+	keybufferCount = 0u;
 }
 
 void Keyboard::ClearEvents() noexcept
@@ -52,15 +54,13 @@ bool Keyboard::AutorepeatIsEnabled() const noexcept
 void Keyboard::OnKeyPressed( unsigned char keycode ) noexcept
 {
 	keystates[keycode] = true;
-	keybuffer.push( Keyboard::Event( Keyboard::Event::Type::PRESS,keycode ) );
-	TrimBuffer( keybuffer );
+	PushEvent( Keyboard::Event( Keyboard::Event::Type::PRESS,keycode ) );
 }
 
 void Keyboard::OnKeyReleased( unsigned char keycode ) noexcept
 {
 	keystates[keycode] = false;
-	keybuffer.push( Keyboard::Event( Keyboard::Event::Type::RELEASE,keycode ) );
-	TrimBuffer( keybuffer );
+	PushEvent( Keyboard::Event( Keyboard::Event::Type::RELEASE,keycode ) );
 }
 
 void Keyboard::ClearState() noexcept
@@ -68,11 +68,13 @@ void Keyboard::ClearState() noexcept
 	keystates.reset();
 }
 
-template<typename T>
-void Keyboard::TrimBuffer( std::queue<T>& buffer ) noexcept
+void Keyboard::PushEvent( Event e ) noexcept
 {
-	while( buffer.size() > bufferSize )
+	if( keybufferCount == bufferSize )
 	{
-		buffer.pop();
+		keybufferStart = (keybufferStart + 1u) % bufferSize;
+		keybufferCount--;
 	}
+	keybuffer[(keybufferStart + keybufferCount) % bufferSize] = e;
+	keybufferCount++;
 }
@@ -1,6 +1,5 @@
 #pragma once
 #pragma once
-#include <queue>
 #include <bitset>
 
 class Keyboard
@@ -65,13 +64,14 @@ private:
 	void OnKeyPressed(unsigned char keycode) noexcept;
 	void OnKeyReleased(unsigned char keycode) noexcept;
 	void ClearState() noexcept;
-	template<typename T>
-	static void TrimBuffer(std::queue<T>& buffer) noexcept;
+	void PushEvent(Event e) noexcept;
 private:
 	static constexpr unsigned int nKeys = 256u;
 	static constexpr unsigned int bufferSize = 16u;
 	bool autorepeatEnabled = false;
 	std::bitset<nKeys> keystates;
-	std::queue<Event> keybuffer;
-	std::queue<char> charbuffer;
+	//Fixed ring of the newest events, the oldest is overwritten when it is full so key presses never allocate
+	Event keybuffer[bufferSize];
+	unsigned int keybufferStart = 0u;
+	unsigned int keybufferCount = 0u;
 };
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "Level.h"
+#include "JobSystem.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include <chrono>
+#include <sstream>
+
+std::mutex Level::constructionMutex;
+
+static const char* const phaseNames[] = { "Parse", "Build chunks", "Build meshes", "Build entities" };
+
+Level::Level(Graphics& gfx, int _levelNum, const ChunkStreamer::Settings& _streamerSettings, LinearArena& _arena) :
+	LevelState(_levelNum, _streamerSettings),
+	arena(_arena),
+	collectablePool(arena)
+{
+	PROFILE_SCOPE("Build level");
+	const auto start = std::chrono::steady_clock::now();
+
+	//Parsing comes first, then chunks and meshes are built side by side, and the entities wait for their meshes' bounds
+	JobCounter parsed;
+	JobCounter meshesBuilt;
+	JobCounter built;
+	JobSystem::Run([this]() { RunPhase(ParsePhase, [this]() { Parse(); }); }, &parsed);
+	JobSystem::Run([this]() { RunPhase(ChunkPhase, [this]() { BuildChunks(); }); }, &built, &parsed);
+	JobSystem::Run([this, &gfx]() { RunPhase(MeshPhase, [this, &gfx]() { BuildMeshes(gfx); }); }, &meshesBuilt, &parsed);
+	JobSystem::Run([this]() { RunPhase(EntityPhase, [this]() { BuildEntities(); }); }, &built, &meshesBuilt);
+	JobSystem::Wait(built);
+
+	buildMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+	PerfCounters::Add(PerfCounters::LevelBuildCounter);
+}
+
+template<typename Function>
+void Level::RunPhase(BuildPhase phase, const Function& function)
+{
+	PROFILE_SCOPE(phaseNames[phase]);
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	phaseMilliseconds[phase] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//Loads the models and textures of the items and bridges, the entities take their boxes from the meshes
+//The first object of a type sets up the bindables every object of the type shares, the other collectables are then built in parallel
+void Level::BuildMeshes(Graphics& gfx)
+{
+	std::lock_guard<std::mutex> lock(constructionMutex);
+
+	std::vector<const LevelData::Marker*> collectableMarkers;
+	for (size_t i = 0; i < levelData.GetMarkerCount(); i++)
+	{
+		const LevelData::Marker& marker = levelData.GetMarkers()[i];
+		if (marker.item == LevelData::Collectable)
+		{
+			collectableMarkers.push_back(&marker);
+		}
+		else if (marker.item == LevelData::Trigger)
+		{
+			const TransformComponent transform = GetTransform(marker);
+			pPressurePlate = arena.Create<TriggerObj>(gfx, GetModelName(TriggerKind), transform.position.x, transform.position.y, transform.position.z,
+				transform.scale.x, transform.scale.y, transform.scale.z);
+		}
+		else if (marker.item == LevelData::Goal)
+		{
+			const TransformComponent transform = GetTransform(marker);
+			pGoal = arena.Create<CustomObj>(gfx, GetModelName(GoalKind), transform.position.x, transform.position.y, transform.position.z, transform.rotation.y,
+				transform.scale.x, transform.scale.y, transform.scale.z, false, false);
+		}
+	}
+
+	for (size_t i = 0; i < levelData.GetTileCount(); i++)
+	{
+		if (levelData.GetTiles()[i].flags & LevelData::Bridge)
+		{
+			pBridgeMesh = arena.Create<Bridge>(gfx, L"bridge.png", 0.0f, 0.0f, 0.0f);
+			break;
+		}
+	}
+
+	auto createCollectable = [this, &gfx, &collectableMarkers](size_t index)
+	{
+		const TransformComponent transform = GetTransform(*collectableMarkers[index]);
+		collectables[index] = collectablePool.Create(gfx, GetModelName(CollectableKind), transform.position.x, transform.position.y, transform.position.z,
+			transform.scale.x, transform.scale.y, transform.scale.z, true, true);
+	};
+
+	collectables.resize(collectableMarkers.size());
+	if (!collectables.empty())
+	{
+		createCollectable(0);
+		JobSystem::ParallelFor(collectables.size() - 1, 1, [&createCollectable](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				createCollectable(i + 1);
+			}
+		});
+	}
+
+	const GameObject* meshes[EntityKindCount] = { collectables.empty() ? nullptr : collectables[0].get(), pPressurePlate, pGoal, pBridgeMesh };
+	for (int kind = 0; kind < EntityKindCount; kind++)
+	{
+		DirectX::XMFLOAT3 meshMin = { 0.0f, 0.0f, 0.0f };
+		DirectX::XMFLOAT3 meshMax = { 0.0f, 0.0f, 0.0f };
+		if (meshes[kind] != nullptr)
+		{
+			meshes[kind]->GetModelBounds(meshMin, meshMax);
+		}
+		modelMin[kind] = { meshMin.x, meshMin.y, meshMin.z };
+		modelMax[kind] = { meshMax.x, meshMax.y, meshMax.z };
+	}
+}
+
+GameObject* Level::GetMesh(EntityKind kind, size_t index) const noexcept
+{
+	switch (kind)
+	{
+	case CollectableKind:
+		return collectables[index].get();
+	case TriggerKind:
+		return pPressurePlate;
+	case GoalKind:
+		return pGoal;
+	default:
+		return pBridgeMesh;
+	}
+}
+
+LinearArena& Level::GetArena() const noexcept
+{
+	return arena;
+}
+
+float Level::GetBuildMilliseconds() const noexcept
+{
+	return buildMilliseconds;
+}
+
+//Time spent in each phase, the phases overlap so their sum over the build time is the speed-up from building in parallel
+std::string Level::GetBuildReport() const
+{
+	float phaseTotal = 0.0f;
+
+	std::ostringstream oss;
+	for (int phase = 0; phase < BuildPhaseCount; phase++)
+	{
+		oss << phaseNames[phase] << " " << phaseMilliseconds[phase] << " ms, ";
+		phaseTotal += phaseMilliseconds[phase];
+	}
+	oss << "built in " << buildMilliseconds << " ms on " << JobSystem::GetThreadCount() << " threads, "
+		<< (buildMilliseconds > 0.0f ? phaseTotal / buildMilliseconds : 1.0f) << "x the serial phase time";
+	return oss.str();
+}
+
+std::string Level::GetAllocationReport() const
+{
+	std::ostringstream oss;
+	oss << "arena " << arena.GetAllocationCount() << " allocations, " << arena.GetPeakBytes() << " peak bytes in "
+		<< arena.GetBlockCount() << " blocks; pool " << collectablePool.GetAllocationCount() << " collectables ("
+		<< collectablePool.GetPeakBytes() << " peak bytes); " << registry.GetEntityCount() << " entities";
+	return oss.str();
+}
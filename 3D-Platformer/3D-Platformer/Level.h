@@ -0,0 +1,60 @@
+#pragma once
+#include "Graphics.h"
+#include "Bridge.h"
+#include "Collectable.h"
+#include "CustomObj.h"
+#include "TriggerObj.h"
+#include "LevelState.h"
+#include "LinearArena.h"
+#include "ObjectPool.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//All objects of one level, built from its LevelData, the simulated part of it is the LevelState it derives from
+//Construction only uses the device, which is free threaded, so a level can be built on a worker thread
+//The build is split into phases run as jobs, see the constructor for their order
+//Static tiles are streamed in chunks around the player
+//Bridge pieces and items are few and always loaded, they are entities of the registry and their objects are only meshes to draw
+//Every object is allocated from the arena the level is built in, either directly or through its pools
+//The arena belongs to whoever builds the level and is reset once the level is destroyed, which frees its objects in one go and keeps the blocks for the next level
+class Level : public LevelState
+{
+public:
+	//GameObjectBase creates its static binds in the first constructor, so only one level builds its meshes at a time
+	static std::mutex constructionMutex;
+
+	enum BuildPhase
+	{
+		ParsePhase,
+		ChunkPhase,
+		MeshPhase,
+		EntityPhase,
+		BuildPhaseCount
+	};
+public:
+	Level(Graphics& gfx, int _levelNum, const ChunkStreamer::Settings& _streamerSettings, LinearArena& _arena);
+	LinearArena& GetArena() const noexcept;
+	float GetBuildMilliseconds() const noexcept;
+	std::string GetBuildReport() const;
+	std::string GetAllocationReport() const;
+private:
+	template<typename Function>
+	void RunPhase(BuildPhase phase, const Function& function);
+	void BuildMeshes(Graphics& gfx);
+	GameObject* GetMesh(EntityKind kind, size_t index) const noexcept override;
+private:
+	//Declared first as the pool carves its slabs out of it
+	LinearArena& arena;
+	ObjectPool<Collectable> collectablePool;
+
+	//Meshes drawn by the registry's renderables
+	std::vector<ObjectPool<Collectable>::Handle> collectables;
+	TriggerObj* pPressurePlate = nullptr;
+	CustomObj* pGoal = nullptr;
+	Bridge* pBridgeMesh = nullptr;
+
+	float buildMilliseconds = 0.0f;
+	float phaseMilliseconds[BuildPhaseCount] = {};
+};
@@ -0,0 +1,81 @@
+#include "LevelChunk.h"
+#include "PerfCounters.h"
+#include <algorithm>
+
+LevelChunk::LevelChunk(const LevelData& levelData, uint32_t _chunkX, uint32_t _chunkZ, uint32_t chunkSize) :
+	chunkX(_chunkX),
+	chunkZ(_chunkZ)
+{
+	PerfCounters::Add(PerfCounters::ChunkLoadCounter);
+	const uint32_t zEnd = (std::min)((chunkZ + 1) * chunkSize, levelData.GetDepth());
+	for (uint32_t z = chunkZ * chunkSize; z < zEnd; z++)
+	{
+		const LevelData::Tile* pBegin = nullptr;
+		const LevelData::Tile* pEnd = nullptr;
+		GetRowTiles(levelData, z, chunkX * chunkSize, (chunkX + 1) * chunkSize, pBegin, pEnd);
+
+		for (const LevelData::Tile* pTile = pBegin; pTile != pEnd; ++pTile)
+		{
+			if (pTile->flags & LevelData::Bridge)
+			{
+				continue;
+			}
+
+			const float x = pTile->x;
+			for (int yVal = 0; yVal <= pTile->height; yVal++)
+			{
+				tiles.push_back({ { x, float(yVal), float(z) }, PlatformTile, 0, 0 });
+			}
+		}
+	}
+}
+
+uint32_t LevelChunk::GetChunkX() const noexcept
+{
+	return chunkX;
+}
+
+uint32_t LevelChunk::GetChunkZ() const noexcept
+{
+	return chunkZ;
+}
+
+size_t LevelChunk::GetMemoryBytes() const noexcept
+{
+	return tiles.size() * sizeof(TileRecord);
+}
+
+//Counts the objects a chunk will create without building it, so the streamer can respect its budget before loading
+size_t LevelChunk::EstimateMemoryBytes(const LevelData& levelData, uint32_t chunkX, uint32_t chunkZ, uint32_t chunkSize)
+{
+	size_t tileCount = 0;
+
+	const uint32_t zEnd = (std::min)((chunkZ + 1) * chunkSize, levelData.GetDepth());
+	for (uint32_t z = chunkZ * chunkSize; z < zEnd; z++)
+	{
+		const LevelData::Tile* pBegin = nullptr;
+		const LevelData::Tile* pEnd = nullptr;
+		GetRowTiles(levelData, z, chunkX * chunkSize, (chunkX + 1) * chunkSize, pBegin, pEnd);
+
+		for (const LevelData::Tile* pTile = pBegin; pTile != pEnd; ++pTile)
+		{
+			if (!(pTile->flags & LevelData::Bridge))
+			{
+				tileCount += size_t((std::max)(int(pTile->height), -1) + 1);
+			}
+		}
+	}
+	return tileCount * sizeof(TileRecord);
+}
+
+//Tiles in a row are sorted by x, so the chunk's slice of the row is found by binary search
+void LevelChunk::GetRowTiles(const LevelData& levelData, uint32_t z, uint32_t xBegin, uint32_t xEnd, const LevelData::Tile*& pBegin, const LevelData::Tile*& pEnd)
+{
+	const LevelData::Tile* pRowBegin = levelData.GetRowBegin(z);
+	const LevelData::Tile* pRowEnd = levelData.GetRowEnd(z);
+
+	pBegin = std::lower_bound(pRowBegin, pRowEnd, xBegin,
+		[](const LevelData::Tile& tile, uint32_t x) { return tile.x < x; });
+	pEnd = std::lower_bound(pBegin, pRowEnd, xEnd,
+		[](const LevelData::Tile& tile, uint32_t x) { return tile.x < x; });
+}
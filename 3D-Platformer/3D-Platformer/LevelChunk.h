@@ -0,0 +1,26 @@
+#pragma once
+#include "LevelData.h"
+#include "MemoryTracker.h"
+#include "TileRecord.h"
+#include <vector>
+
+//The static tiles of one square chunk of a level, as packed records
+//Bridge pieces move, so they are entities of the level's registry rather than part of a chunk
+class LevelChunk
+{
+public:
+	LevelChunk(const LevelData& levelData, uint32_t _chunkX, uint32_t _chunkZ, uint32_t chunkSize);
+	LevelChunk(const LevelChunk&) = delete;
+	LevelChunk& operator=(const LevelChunk&) = delete;
+	uint32_t GetChunkX() const noexcept;
+	uint32_t GetChunkZ() const noexcept;
+	size_t GetMemoryBytes() const noexcept;
+	static size_t EstimateMemoryBytes(const LevelData& levelData, uint32_t chunkX, uint32_t chunkZ, uint32_t chunkSize);
+public:
+	TrackedVector<TileRecord, MemoryTracker::ChunkCategory> tiles;
+private:
+	static void GetRowTiles(const LevelData& levelData, uint32_t z, uint32_t xBegin, uint32_t xEnd, const LevelData::Tile*& pBegin, const LevelData::Tile*& pEnd);
+private:
+	uint32_t chunkX;
+	uint32_t chunkZ;
+};
@@ -0,0 +1,255 @@
+#include "LevelData.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+//Reads the next whitespace separated number, returns false at the end of the text
+static bool ReadValue(const char*& pText, float& value)
+{
+	char* pEnd = nullptr;
+	value = strtof(pText, &pEnd);
+	if (pEnd == pText)
+	{
+		return false;
+	}
+	pText = pEnd;
+	return true;
+}
+
+static size_t AlignOffset(size_t offset)
+{
+	return (offset + 7) & ~size_t(7);
+}
+
+//Follows the same rules InitialiseLevel used on the text grids:
+//-1 is empty, a positive value is a column of boxes up to that height, any other negative value is a bridge at -value
+//Items are only placed on populated cells
+bool LevelData::ParseText(const std::string& levelText, const std::string& itemText)
+{
+	Clear();
+
+	const char* pLevel = levelText.c_str();
+	const char* pItem = itemText.c_str();
+
+	float levelWidth = 0.0f;
+	float levelDepth = 0.0f;
+	if (!ReadValue(pLevel, levelWidth) || !ReadValue(pLevel, levelDepth) || levelWidth < 1.0f || levelWidth > 65535.0f)
+	{
+		return false;
+	}
+
+	width = static_cast<uint32_t>(levelWidth);
+	uint32_t x = 0;
+	uint32_t z = 0;
+	rowOffsets.push_back(0);
+
+	float levelValue = 0.0f;
+	float itemValue = 0.0f;
+	while (z <= 65535 && ReadValue(pLevel, levelValue) && ReadValue(pItem, itemValue))
+	{
+		if (levelValue != -1.0f)
+		{
+			Tile tile = {};
+			tile.x = static_cast<uint16_t>(x);
+			tile.z = static_cast<uint16_t>(z);
+			if (levelValue >= 0.0f)
+			{
+				tile.height = static_cast<int16_t>(std::floor(levelValue));
+			}
+			else
+			{
+				tile.height = static_cast<int16_t>(-levelValue);
+				tile.flags = Bridge;
+			}
+			tiles.push_back(tile);
+
+			if (itemValue == std::floor(itemValue) && itemValue >= float(Spawn) && itemValue <= float(Goal))
+			{
+				markers.push_back({ static_cast<uint32_t>(itemValue), float(x), float(tile.height), float(z) });
+			}
+		}
+
+		//Change position of next cell
+		if (++x >= width)
+		{
+			x = 0;
+			z++;
+			rowOffsets.push_back(static_cast<uint32_t>(tiles.size()));
+		}
+	}
+
+	//A partial last row still gets an entry, and rows the header promises but the grid lacks are empty
+	if (x > 0)
+	{
+		rowOffsets.push_back(static_cast<uint32_t>(tiles.size()));
+	}
+	while (rowOffsets.size() < size_t(levelDepth) + 1 && rowOffsets.size() <= 65536)
+	{
+		rowOffsets.push_back(static_cast<uint32_t>(tiles.size()));
+	}
+
+	depth = static_cast<uint32_t>(rowOffsets.size() - 1);
+	tileCount = static_cast<uint32_t>(tiles.size());
+	markerCount = static_cast<uint32_t>(markers.size());
+	pRowOffsets = rowOffsets.data();
+	pTiles = tiles.data();
+	pMarkers = markers.data();
+	return true;
+}
+
+bool LevelData::Load(VirtualFile _file)
+{
+	Clear();
+	file = std::move(_file);
+	if (!LoadView(file.GetData(), file.GetSize()))
+	{
+		file = VirtualFile();
+		return false;
+	}
+	return true;
+}
+
+//The data must outlive this object, nothing is copied
+bool LevelData::LoadView(const uint8_t* pData, size_t size)
+{
+	pRowOffsets = nullptr;
+	pTiles = nullptr;
+	pMarkers = nullptr;
+	width = depth = tileCount = markerCount = 0;
+
+	if (pData == nullptr || size < sizeof(Header))
+	{
+		return false;
+	}
+
+	const Header* pHeader = reinterpret_cast<const Header*>(pData);
+	if (memcmp(pHeader->magic, "LVL1", 4) != 0 || pHeader->version != version)
+	{
+		return false;
+	}
+
+	//Validate that every table lies inside the data
+	const uint64_t rowOffsetsSize = (uint64_t(pHeader->depth) + 1) * sizeof(uint32_t);
+	const uint64_t tilesSize = uint64_t(pHeader->tileCount) * sizeof(Tile);
+	const uint64_t markersSize = uint64_t(pHeader->markerCount) * sizeof(Marker);
+	if (pHeader->rowOffsetsOffset % alignof(uint32_t) != 0 || pHeader->tilesOffset % alignof(Tile) != 0 || pHeader->markersOffset % alignof(Marker) != 0 ||
+		pHeader->rowOffsetsOffset > size || rowOffsetsSize > size - pHeader->rowOffsetsOffset ||
+		pHeader->tilesOffset > size || tilesSize > size - pHeader->tilesOffset ||
+		pHeader->markersOffset > size || markersSize > size - pHeader->markersOffset)
+	{
+		return false;
+	}
+
+	//Row lookups index straight into the tiles, so the offsets have to be in order and in range
+	//and every tile has to sit inside the grid, in the row it is stored under
+	const uint32_t* pFileRowOffsets = reinterpret_cast<const uint32_t*>(pData + pHeader->rowOffsetsOffset);
+	const Tile* pFileTiles = reinterpret_cast<const Tile*>(pData + pHeader->tilesOffset);
+	if (pFileRowOffsets[0] != 0 || pFileRowOffsets[pHeader->depth] != pHeader->tileCount)
+	{
+		return false;
+	}
+	for (uint32_t z = 0; z < pHeader->depth; z++)
+	{
+		if (pFileRowOffsets[z] > pFileRowOffsets[z + 1])
+		{
+			return false;
+		}
+		for (uint32_t i = pFileRowOffsets[z]; i < pFileRowOffsets[z + 1]; i++)
+		{
+			if (pFileTiles[i].x >= pHeader->width || pFileTiles[i].z != z)
+			{
+				return false;
+			}
+		}
+	}
+
+	width = pHeader->width;
+	depth = pHeader->depth;
+	tileCount = pHeader->tileCount;
+	markerCount = pHeader->markerCount;
+	pRowOffsets = pFileRowOffsets;
+	pTiles = pFileTiles;
+	pMarkers = reinterpret_cast<const Marker*>(pData + pHeader->markersOffset);
+	return true;
+}
+
+void LevelData::Write(std::vector<uint8_t>& out) const
+{
+	Header header = {};
+	memcpy(header.magic, "LVL1", 4);
+	header.version = version;
+	header.width = width;
+	header.depth = depth;
+	header.tileCount = tileCount;
+	header.markerCount = markerCount;
+	header.rowOffsetsOffset = AlignOffset(sizeof(Header));
+	header.tilesOffset = AlignOffset(header.rowOffsetsOffset + (size_t(depth) + 1) * sizeof(uint32_t));
+	header.markersOffset = AlignOffset(header.tilesOffset + size_t(tileCount) * sizeof(Tile));
+
+	out.assign(header.markersOffset + size_t(markerCount) * sizeof(Marker), 0);
+	memcpy(out.data(), &header, sizeof(Header));
+	if (pRowOffsets != nullptr)
+	{
+		memcpy(out.data() + header.rowOffsetsOffset, pRowOffsets, (size_t(depth) + 1) * sizeof(uint32_t));
+	}
+	if (tileCount > 0)
+	{
+		memcpy(out.data() + header.tilesOffset, pTiles, size_t(tileCount) * sizeof(Tile));
+	}
+	if (markerCount > 0)
+	{
+		memcpy(out.data() + header.markersOffset, pMarkers, size_t(markerCount) * sizeof(Marker));
+	}
+}
+
+void LevelData::Clear() noexcept
+{
+	width = depth = tileCount = markerCount = 0;
+	pRowOffsets = nullptr;
+	pTiles = nullptr;
+	pMarkers = nullptr;
+	file = VirtualFile();
+	rowOffsets.clear();
+	tiles.clear();
+	markers.clear();
+}
+
+uint32_t LevelData::GetWidth() const noexcept
+{
+	return width;
+}
+
+uint32_t LevelData::GetDepth() const noexcept
+{
+	return depth;
+}
+
+size_t LevelData::GetTileCount() const noexcept
+{
+	return tileCount;
+}
+
+const LevelData::Tile* LevelData::GetTiles() const noexcept
+{
+	return pTiles;
+}
+
+const LevelData::Tile* LevelData::GetRowBegin(uint32_t z) const noexcept
+{
+	return z < depth ? pTiles + pRowOffsets[z] : pTiles + tileCount;
+}
+
+const LevelData::Tile* LevelData::GetRowEnd(uint32_t z) const noexcept
+{
+	return z < depth ? pTiles + pRowOffsets[z + 1] : pTiles + tileCount;
+}
+
+size_t LevelData::GetMarkerCount() const noexcept
+{
+	return markerCount;
+}
+
+const LevelData::Marker* LevelData::GetMarkers() const noexcept
+{
+	return pMarkers;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include "MemoryTracker.h"
+#include "VirtualFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Level layout shared by the text grids (LevelN.txt + LevelN_Items.txt) and the compiled binary format (LevelN.lvl)
+//Binary layout: Header | Row offsets (depth + 1) | Tiles sorted by row then column | Markers
+//Only populated tiles are stored, and the binary file is used in place so loading costs nothing per empty cell
+class LevelData
+{
+public:
+	static constexpr uint32_t version = 1;
+
+	enum TileFlags : uint16_t
+	{
+		Bridge = 1u << 0
+	};
+
+	//Item values used in the text item grid
+	enum ItemType : uint32_t
+	{
+		Spawn = 2,
+		Collectable = 3,
+		Trigger = 4,
+		Goal = 5
+	};
+
+	struct Header
+	{
+		char magic[4];
+		uint32_t version;
+		uint32_t width;
+		uint32_t depth;
+		uint32_t tileCount;
+		uint32_t markerCount;
+		uint64_t rowOffsetsOffset;
+		uint64_t tilesOffset;
+		uint64_t markersOffset;
+	};
+
+	//A column of boxes from 0 up to height, or a bridge piece at height
+	struct Tile
+	{
+		uint16_t x;
+		uint16_t z;
+		int16_t height;
+		uint16_t flags;
+	};
+
+	//Item placed on top of a tile, resolved to the tile's position
+	struct Marker
+	{
+		uint32_t item;
+		float x;
+		float y;
+		float z;
+	};
+public:
+	LevelData() = default;
+	LevelData(const LevelData&) = delete;
+	LevelData& operator=(const LevelData&) = delete;
+	LevelData(LevelData&&) = default;
+	LevelData& operator=(LevelData&&) = default;
+
+	bool ParseText(const std::string& levelText, const std::string& itemText);
+	bool Load(VirtualFile file);
+	bool LoadView(const uint8_t* pData, size_t size);
+	void Write(std::vector<uint8_t>& out) const;
+	void Clear() noexcept;
+
+	uint32_t GetWidth() const noexcept;
+	uint32_t GetDepth() const noexcept;
+	size_t GetTileCount() const noexcept;
+	const Tile* GetTiles() const noexcept;
+	const Tile* GetRowBegin(uint32_t z) const noexcept;
+	const Tile* GetRowEnd(uint32_t z) const noexcept;
+	size_t GetMarkerCount() const noexcept;
+	const Marker* GetMarkers() const noexcept;
+private:
+	uint32_t width = 0;
+	uint32_t depth = 0;
+	uint32_t tileCount = 0;
+	uint32_t markerCount = 0;
+
+	//Point either into the binary file or into the vectors filled by ParseText
+	const uint32_t* pRowOffsets = nullptr;
+	const Tile* pTiles = nullptr;
+	const Marker* pMarkers = nullptr;
+
+	VirtualFile file;
+	TrackedVector<uint32_t, MemoryTracker::LevelDataCategory> rowOffsets;
+	TrackedVector<Tile, MemoryTracker::LevelDataCategory> tiles;
+	TrackedVector<Marker, MemoryTracker::LevelDataCategory> markers;
+};
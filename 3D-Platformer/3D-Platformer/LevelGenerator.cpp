@@ -0,0 +1,189 @@
+#include "LevelGenerator.h"
+#include "LevelData.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+void LevelGenerator::GenerateText(uint32_t size, uint32_t seed, std::string& levelText, std::string& itemText)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+	levelText = std::to_string(size) + "\t" + std::to_string(size) + "\n";
+	itemText.clear();
+
+	for (uint32_t z = 0; z < size; z++)
+	{
+		for (uint32_t x = 0; x < size; x++)
+		{
+			const char* separator = x + 1 < size ? "\t" : "\n";
+			if (chance(random) > 0.1f)
+			{
+				levelText += "-1";
+				itemText += "-1";
+			}
+			else
+			{
+				levelText += chance(random) < 0.05f ? "-2" : std::to_string(static_cast<int>(chance(random) * 4.0f));
+				const float item = chance(random);
+				itemText += (x == 0 && z == 0) ? "2" : item < 0.02f ? "3" : item < 0.0201f ? "4" : item < 0.0202f ? "5" : "-1";
+			}
+			levelText += separator;
+			itemText += separator;
+		}
+	}
+}
+
+static const char* const heightNames[LevelGenerator::HeightDistributionCount] = { "flat", "uniform", "terrain" };
+
+//mt19937's output is the same everywhere but the standard distributions are not, so the generator scales it itself
+static float NextChance(std::mt19937& random) noexcept
+{
+	return float(random() >> 8) * (1.0f / 16777216.0f);
+}
+
+//Bilinear value noise from 0 to 1, one random value at every featureSize-th cell and smooth between them
+static float SampleTerrain(const std::vector<float>& lattice, uint32_t latticeWidth, uint32_t x, uint32_t z, uint32_t featureSize) noexcept
+{
+	const uint32_t cellX = x / featureSize;
+	const uint32_t cellZ = z / featureSize;
+	const float tx = float(x % featureSize) / float(featureSize);
+	const float tz = float(z % featureSize) / float(featureSize);
+	//Smoothstep, so the slopes meet without creases
+	const float sx = tx * tx * (3.0f - 2.0f * tx);
+	const float sz = tz * tz * (3.0f - 2.0f * tz);
+
+	const float* pRow = lattice.data() + size_t(cellZ) * latticeWidth + cellX;
+	const float nearRow = pRow[0] + (pRow[1] - pRow[0]) * sx;
+	const float farRow = pRow[latticeWidth] + (pRow[latticeWidth + 1] - pRow[latticeWidth]) * sx;
+	return nearRow + (farRow - nearRow) * sz;
+}
+
+//The grids are filled first so the items can be placed on columns picked from the whole level, then written out row by row
+bool LevelGenerator::Generate(const Settings& settings, std::string& levelText, std::string& itemText, Stats* pStats)
+{
+	const uint64_t cellCount = uint64_t(settings.width) * settings.depth;
+	if (settings.width < 1 || settings.depth < 1 || settings.width > 65535 || settings.depth > 65535 || cellCount > (uint64_t(1) << 28))
+	{
+		return false;
+	}
+
+	std::mt19937 random(settings.seed);
+	const int maxHeight = (std::max)(0, (std::min)(settings.maxHeight, 32767));
+	const uint32_t featureSize = (std::max)(settings.featureSize, 1u);
+
+	std::vector<float> lattice;
+	const uint32_t latticeWidth = settings.width / featureSize + 2;
+	const uint32_t latticeDepth = settings.depth / featureSize + 2;
+	if (settings.heights == TerrainHeights)
+	{
+		lattice.resize(size_t(latticeWidth) * latticeDepth);
+		for (float& value : lattice)
+		{
+			value = NextChance(random);
+		}
+	}
+
+	//Grid values as the text writes them, -1 empty, a height, or minus the height of a bridge piece
+	std::vector<int16_t> grid(size_t(cellCount), -1);
+	std::vector<uint32_t> columns;
+	size_t bridgeCount = 0;
+	for (uint32_t z = 0; z < settings.depth; z++)
+	{
+		for (uint32_t x = 0; x < settings.width; x++)
+		{
+			//All three are drawn for every cell, so changing one setting does not reshuffle the rest of the level
+			const float fillChance = NextChance(random);
+			const float bridgeChance = NextChance(random);
+			const float heightChance = NextChance(random);
+			if (fillChance >= settings.fill)
+			{
+				continue;
+			}
+
+			int height = maxHeight;
+			if (settings.heights == UniformHeights)
+			{
+				height = (std::min)(int(heightChance * float(maxHeight + 1)), maxHeight);
+			}
+			else if (settings.heights == TerrainHeights)
+			{
+				height = (std::min)(int(SampleTerrain(lattice, latticeWidth, x, z, featureSize) * float(maxHeight + 1)), maxHeight);
+			}
+
+			const size_t cell = size_t(z) * settings.width + x;
+			//-1 means an empty cell, so bridge pieces are at least 2 high
+			if (bridgeChance < settings.bridgeDensity)
+			{
+				grid[cell] = int16_t(-(std::max)(height, 2));
+				bridgeCount++;
+			}
+			else
+			{
+				grid[cell] = int16_t(height);
+				columns.push_back(uint32_t(cell));
+			}
+		}
+	}
+
+	//A level needs somewhere to start
+	if (columns.empty())
+	{
+		bridgeCount -= grid[0] < -1 ? 1 : 0;
+		grid[0] = 0;
+		columns.push_back(0);
+	}
+
+	//Spawn on the first column, the goal on the last and the trigger on a random one, then the collectables on columns left free
+	std::vector<int8_t> items(size_t(cellCount), -1);
+	items[columns.front()] = int8_t(LevelData::Spawn);
+	if (columns.size() > 1)
+	{
+		items[columns.back()] = int8_t(LevelData::Goal);
+	}
+	if (columns.size() > 2)
+	{
+		items[columns[1 + random() % (columns.size() - 2)]] = int8_t(LevelData::Trigger);
+	}
+
+	const size_t freeColumns = columns.size() - (std::min)(columns.size(), size_t(3));
+	const size_t collectableCount = (std::min)(size_t(settings.collectableCount), freeColumns);
+	for (size_t placed = 0; placed < collectableCount;)
+	{
+		const uint32_t cell = columns[random() % columns.size()];
+		if (items[cell] == -1)
+		{
+			items[cell] = int8_t(LevelData::Collectable);
+			placed++;
+		}
+	}
+
+	//Most cells are a couple of characters and a tab
+	levelText = std::to_string(settings.width) + "\t" + std::to_string(settings.depth) + "\n";
+	itemText.clear();
+	levelText.reserve(size_t(cellCount) * 3 + levelText.size());
+	itemText.reserve(size_t(cellCount) * 3);
+	for (uint32_t z = 0; z < settings.depth; z++)
+	{
+		for (uint32_t x = 0; x < settings.width; x++)
+		{
+			const size_t cell = size_t(z) * settings.width + x;
+			const char* separator = x + 1 < settings.width ? "\t" : "\n";
+			levelText += std::to_string(grid[cell]);
+			levelText += separator;
+			itemText += std::to_string(items[cell]);
+			itemText += separator;
+		}
+	}
+
+	if (pStats != nullptr)
+	{
+		*pStats = { columns.size() + bridgeCount, bridgeCount, collectableCount };
+	}
+	return true;
+}
+
+const char* LevelGenerator::GetName(HeightDistribution heights) noexcept
+{
+	return heightNames[heights];
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+//Makes large levels in the text grid format for benchmarks and stress tests
+class LevelGenerator
+{
+public:
+	enum HeightDistribution
+	{
+		FlatHeights,
+		UniformHeights,
+		TerrainHeights,
+		HeightDistributionCount
+	};
+
+	struct Settings
+	{
+		uint32_t width = 256;
+		uint32_t depth = 256;
+		uint32_t seed = 1234;
+		//Fraction of the cells with a column or a bridge piece in them
+		float fill = 0.5f;
+		//Columns are 0 to maxHeight boxes tall, every one maxHeight when flat, independent when uniform, in rolling hills as terrain
+		HeightDistribution heights = TerrainHeights;
+		int maxHeight = 8;
+		//Cells from one terrain hill to the next
+		uint32_t featureSize = 16;
+		//Fraction of the populated cells that are bridge pieces
+		float bridgeDensity = 0.02f;
+		//Placed on distinct columns, fewer if there are not enough of them
+		uint32_t collectableCount = 64;
+	};
+
+	//Totals of what a generated level holds
+	struct Stats
+	{
+		size_t tileCount;
+		size_t bridgeCount;
+		size_t collectableCount;
+	};
+public:
+	//A size x size pair of grids, mostly empty like the hand made levels, the same every time for a seed
+	static void GenerateText(uint32_t size, uint32_t seed, std::string& levelText, std::string& itemText);
+	//A level shaped by the settings with a spawn, a trigger for its bridges and a goal, the same on every platform for a seed
+	//Fails when the grid is larger than 65535 cells on a side or 2^28 cells in all
+	static bool Generate(const Settings& settings, std::string& levelText, std::string& itemText, Stats* pStats = nullptr);
+
+	static const char* GetName(HeightDistribution heights) noexcept;
+};
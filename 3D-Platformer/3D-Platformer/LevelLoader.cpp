@@ -0,0 +1,152 @@
+#include "LevelLoader.h"
+#include "Profiler.h"
+#include "VirtualFileSystem.h"
+#include <sstream>
+
+LevelLoader::LevelLoader(Graphics& gfx, const ChunkStreamer::Settings& _streamerSettings) :
+	gfx(gfx),
+	streamerSettings(_streamerSettings)
+{
+	worker = std::thread(&LevelLoader::WorkerLoop, this);
+}
+
+LevelLoader::~LevelLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	workCondition.notify_all();
+	worker.join();
+}
+
+//Replaces any level that was requested but not taken yet
+void LevelLoader::Request(int levelNum)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		requestedLevel = levelNum;
+		if (pReadyLevel && pReadyLevel->GetLevelNum() != levelNum)
+		{
+			retiredLevels.push_back(std::move(pReadyLevel));
+		}
+	}
+	workCondition.notify_all();
+}
+
+bool LevelLoader::IsReady(int levelNum)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return pReadyLevel && pReadyLevel->GetLevelNum() == levelNum;
+}
+
+//Waits for the level to finish building if it is still in progress
+std::unique_ptr<Level> LevelLoader::Take(int levelNum)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (requestedLevel != levelNum && !(pReadyLevel && pReadyLevel->GetLevelNum() == levelNum))
+	{
+		requestedLevel = levelNum;
+		workCondition.notify_all();
+	}
+	readyCondition.wait(lock, [this, levelNum]() { return pReadyLevel && pReadyLevel->GetLevelNum() == levelNum; });
+	return std::move(pReadyLevel);
+}
+
+void LevelLoader::Retire(std::unique_ptr<Level> pLevel)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		retiredLevels.push_back(std::move(pLevel));
+	}
+	workCondition.notify_all();
+}
+
+void LevelLoader::WorkerLoop()
+{
+	PROFILE_THREAD("Level loader");
+
+	//WIC texture decoding needs COM on this thread
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	while (true)
+	{
+		int levelNum = 0;
+		std::vector<std::unique_ptr<Level>> levelsToDestroy;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			workCondition.wait(lock, [this]()
+			{
+				return stopping || !retiredLevels.empty() ||
+					(requestedLevel != 0 && !(pReadyLevel && pReadyLevel->GetLevelNum() == requestedLevel));
+			});
+			if (stopping)
+			{
+				break;
+			}
+			levelsToDestroy.swap(retiredLevels);
+			if (requestedLevel != 0 && !(pReadyLevel && pReadyLevel->GetLevelNum() == requestedLevel))
+			{
+				levelNum = requestedLevel;
+			}
+		}
+
+		//Releasing thousands of objects is as slow as creating them, so it happens here instead of on the frame
+		{
+			PROFILE_SCOPE("Destroy levels");
+			for (std::unique_ptr<Level>& pLevel : levelsToDestroy)
+			{
+				DestroyLevel(std::move(pLevel));
+			}
+			levelsToDestroy.clear();
+		}
+
+		if (levelNum != 0)
+		{
+			auto pLevel = std::make_unique<Level>(gfx, levelNum, streamerSettings, TakeArena());
+
+			std::ostringstream oss;
+			oss << "Level " << levelNum << " built in the background: " << pLevel->GetBuildReport() << "\n"
+				<< "Level " << levelNum << " memory: " << pLevel->GetAllocationReport() << "\n";
+			OutputDebugStringA(oss.str().c_str());
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (requestedLevel == levelNum)
+				{
+					pReadyLevel = std::move(pLevel);
+				}
+			}
+			readyCondition.notify_all();
+
+			//Another level was requested while this one was built
+			if (pLevel)
+			{
+				DestroyLevel(std::move(pLevel));
+			}
+		}
+	}
+
+	CoUninitialize();
+}
+
+LinearArena& LevelLoader::TakeArena()
+{
+	if (freeArenas.empty())
+	{
+		arenas.push_back(std::make_unique<LinearArena>());
+		return *arenas.back();
+	}
+	LinearArena* pArena = freeArenas.back();
+	freeArenas.pop_back();
+	return *pArena;
+}
+
+//The arena is reset after the level is gone, its objects have already let go of their pool slots by then
+void LevelLoader::DestroyLevel(std::unique_ptr<Level> pLevel)
+{
+	LinearArena& arena = pLevel->GetArena();
+	pLevel.reset();
+	arena.Reset();
+	freeArenas.push_back(&arena);
+}
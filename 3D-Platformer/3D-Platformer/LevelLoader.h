@@ -0,0 +1,42 @@
+#pragma once
+#include "Level.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Builds the next level on a worker thread while the current one is played
+//Finished levels are handed over with Take, and old levels are destroyed on the worker with Retire
+//Levels are built in arenas the loader keeps, usually two as the level being played and the next one live side by side, an arena is reset and reused once its level is destroyed
+class LevelLoader
+{
+public:
+	LevelLoader(Graphics& gfx, const ChunkStreamer::Settings& _streamerSettings);
+	~LevelLoader();
+	LevelLoader(const LevelLoader&) = delete;
+	LevelLoader& operator=(const LevelLoader&) = delete;
+
+	void Request(int levelNum);
+	bool IsReady(int levelNum);
+	std::unique_ptr<Level> Take(int levelNum);
+	void Retire(std::unique_ptr<Level> pLevel);
+private:
+	void WorkerLoop();
+	LinearArena& TakeArena();
+	void DestroyLevel(std::unique_ptr<Level> pLevel);
+private:
+	Graphics& gfx;
+	ChunkStreamer::Settings streamerSettings;
+	//Only used on the worker, declared before the levels so it outlives them
+	std::vector<std::unique_ptr<LinearArena>> arenas;
+	std::vector<LinearArena*> freeArenas;
+	std::mutex mutex;
+	std::condition_variable workCondition;
+	std::condition_variable readyCondition;
+	int requestedLevel = 0;
+	std::unique_ptr<Level> pReadyLevel;
+	std::vector<std::unique_ptr<Level>> retiredLevels;
+	bool stopping = false;
+	std::thread worker;
+};
@@ -0,0 +1,209 @@
+#include "LevelState.h"
+#include "ObjModel.h"
+#include "Systems.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <cfloat>
+
+static const wchar_t* const modelNames[] = { L"CHAHIN_BOTTLE_OF_SODA", L"BRB", L"flag", nullptr };
+
+LevelState::LevelState(int _levelNum, const ChunkStreamer::Settings& _streamerSettings) :
+	streamerSettings(_streamerSettings),
+	levelNum(_levelNum)
+{
+}
+
+//Built in order on the calling thread, the simulation needs nothing else
+std::unique_ptr<LevelState> LevelState::BuildHeadless(int levelNum, const ChunkStreamer::Settings& streamerSettings)
+{
+	std::unique_ptr<LevelState> pLevel(new LevelState(levelNum, streamerSettings));
+	pLevel->Parse();
+	pLevel->BuildChunks();
+	pLevel->LoadModelBounds();
+	pLevel->BuildEntities();
+	return pLevel;
+}
+
+//Use the compiled level when it has been built, otherwise parse the text grids
+void LevelState::Parse()
+{
+	const std::string binaryFileName = GetFileName(levelNum, ".lvl");
+	if (!VirtualFileSystem::Exists(binaryFileName) || !levelData.Load(VirtualFileSystem::Open(binaryFileName)))
+	{
+		levelData.ParseText(VirtualFileSystem::Open(GetFileName(levelNum, ".txt")).ToString(),
+			VirtualFileSystem::Open(GetFileName(levelNum, "_Items.txt")).ToString());
+	}
+
+	for (size_t i = 0; i < levelData.GetMarkerCount(); i++)
+	{
+		const LevelData::Marker& marker = levelData.GetMarkers()[i];
+		if (marker.item == LevelData::Spawn)
+		{
+			spawnPosition = { marker.x, marker.y + 1, marker.z };
+		}
+	}
+}
+
+//The tiles around the spawn point are built now so the level is playable as soon as it is swapped in
+void LevelState::BuildChunks()
+{
+	pStreamer = std::make_unique<ChunkStreamer>(levelData, streamerSettings);
+	pStreamer->LoadAround(spawnPosition.x, spawnPosition.z);
+}
+
+//The same box GameObject::CreateBoundingBox makes around the loaded vertices, without creating the mesh
+void LevelState::LoadModelBounds()
+{
+	for (int kind = 0; kind < EntityKindCount; kind++)
+	{
+		const wchar_t* modelName = GetModelName(EntityKind(kind));
+		if (modelName == nullptr)
+		{
+			modelMin[kind] = { -0.5f, -0.5f, -0.5f };
+			modelMax[kind] = { 0.5f, 0.5f, 0.5f };
+			continue;
+		}
+
+		ObjModel model;
+		model.ParseObj(VirtualFileSystem::Open(std::wstring(L"3DObjects\\") + modelName + L".obj").ToWideString());
+		//Like GameObject::GetModelBounds, a mesh without vertices has an empty box
+		if (model.vertices.empty())
+		{
+			modelMin[kind] = {};
+			modelMax[kind] = {};
+			continue;
+		}
+
+		Float3 boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		Float3 boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (const ObjModel::Vertex& vertex : model.vertices)
+		{
+			boundsMin = { (std::min)(boundsMin.x, vertex.pos.x), (std::min)(boundsMin.y, vertex.pos.y), (std::min)(boundsMin.z, vertex.pos.z) };
+			boundsMax = { (std::max)(boundsMax.x, vertex.pos.x), (std::max)(boundsMax.y, vertex.pos.y), (std::max)(boundsMax.z, vertex.pos.z) };
+		}
+		modelMin[kind] = boundsMin;
+		modelMax[kind] = boundsMax;
+	}
+}
+
+//Registry entities in the order of the markers, then the bridge pieces
+void LevelState::BuildEntities()
+{
+	size_t collectableIndex = 0;
+	for (size_t i = 0; i < levelData.GetMarkerCount(); i++)
+	{
+		const LevelData::Marker& marker = levelData.GetMarkers()[i];
+		const TransformComponent transform = GetTransform(marker);
+
+		//Collectable, spins until it is picked up
+		if (marker.item == LevelData::Collectable)
+		{
+			const Entity entity = AddEntity(CollectableKind, collectableIndex++, transform, OverlapCollider);
+			registry.animators.Add(entity, { transform.position.y, 1.0f, transform.position.y, 1.0f, 1.0f, NoAnimatorGroup });
+			registry.triggers.Add(entity, { CollectTrigger, NoAnimatorGroup, false });
+		}
+		//Trigger, sinks into the ground and raises the bridges
+		else if (marker.item == LevelData::Trigger)
+		{
+			const Entity entity = AddEntity(TriggerKind, 0, transform, OverlapCollider);
+			registry.animators.Add(entity, { transform.position.y, 1.0f, transform.position.y - 0.2f, 4.0f, 0.0f, NoAnimatorGroup });
+			registry.triggers.Add(entity, { ActivateGroupTrigger, BridgeAnimatorGroup, false });
+		}
+		//Goal
+		else if (marker.item == LevelData::Goal)
+		{
+			const Entity entity = AddEntity(GoalKind, 0, transform, OverlapCollider);
+			registry.triggers.Add(entity, { GoalTrigger, NoAnimatorGroup, false });
+		}
+	}
+
+	//Bridge pieces start lowered and share one mesh
+	for (size_t i = 0; i < levelData.GetTileCount(); i++)
+	{
+		const LevelData::Tile& tile = levelData.GetTiles()[i];
+		if (!(tile.flags & LevelData::Bridge))
+		{
+			continue;
+		}
+
+		const TransformComponent transform = { { float(tile.x), 0.0f, float(tile.z) }, {}, { 1.0f, 1.0f, 1.0f } };
+		const Entity entity = AddEntity(BridgeKind, 0, transform, SolidCollider);
+		registry.animators.Add(entity, { 0.0f, 1.0f, float(tile.height), 1.0f, 0.0f, BridgeAnimatorGroup });
+	}
+
+	TransformSystem::Update(registry);
+}
+
+GameObject* LevelState::GetMesh(EntityKind, size_t) const noexcept
+{
+	return nullptr;
+}
+
+//Where an item's mesh is placed relative to the tile its marker is on
+TransformComponent LevelState::GetTransform(const LevelData::Marker& marker) noexcept
+{
+	switch (marker.item)
+	{
+	case LevelData::Collectable:
+		return { { marker.x, marker.y + 1.5f, marker.z }, {}, { 0.25f, 0.25f, 0.25f } };
+	case LevelData::Trigger:
+		return { { marker.x, marker.y + 0.7f, marker.z }, {}, { 7.0f, 7.0f, 7.0f } };
+	case LevelData::Goal:
+		return { { marker.x + 4.5f, marker.y + 0.5f, marker.z }, { 0.0f, DirectX::XM_PI, 0.0f }, { 0.25f, 0.25f, 0.25f } };
+	default:
+		return { { marker.x, marker.y, marker.z }, {}, { 1.0f, 1.0f, 1.0f } };
+	}
+}
+
+void LevelState::Update(float playerX, float playerZ)
+{
+	pStreamer->Update(playerX, playerZ);
+}
+
+void LevelState::ResetChunks()
+{
+	pStreamer.reset();
+	BuildChunks();
+}
+
+const std::vector<LevelChunk*>& LevelState::GetChunks() const noexcept
+{
+	return pStreamer->GetLoadedChunks();
+}
+
+size_t LevelState::GetChunkBytes() const noexcept
+{
+	return pStreamer->GetLoadedBytes();
+}
+
+int LevelState::GetLevelNum() const noexcept
+{
+	return levelNum;
+}
+
+std::string LevelState::GetFileName(int levelNum, const char* suffix)
+{
+	return "Resources/Level" + std::to_string(levelNum) + suffix;
+}
+
+const wchar_t* LevelState::GetModelName(EntityKind kind) noexcept
+{
+	return modelNames[kind];
+}
+
+//Entity drawn with the kind's mesh at the transform, colliding with the kind's model box
+Entity LevelState::AddEntity(EntityKind kind, size_t index, const TransformComponent& transform, ColliderType colliderType)
+{
+	BoundsComponent bounds;
+	bounds.modelMin = modelMin[kind];
+	bounds.modelMax = modelMax[kind];
+
+	const Entity entity = registry.Create();
+	registry.transforms.Add(entity, transform);
+	registry.worlds.Add(entity, WorldComponent());
+	registry.bounds.Add(entity, bounds);
+	registry.renderables.Add(entity, { GetMesh(kind, index), true });
+	registry.colliders.Add(entity, { colliderType });
+	registry.MarkDirty(entity);
+	return entity;
+}
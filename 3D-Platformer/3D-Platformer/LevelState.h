@@ -0,0 +1,67 @@
+#pragma once
+#include "ChunkStreamer.h"
+#include "LevelData.h"
+#include "Registry.h"
+#include <DirectXMath.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+//The part of a level the simulation runs on, its layout, streamed tiles and entities, without anything that needs the device
+//Level adds the meshes drawn for the entities, a headless level built with BuildHeadless only reads the models' bounds
+class LevelState
+{
+public:
+	static constexpr int levelCount = 3;
+
+	//Entities that share a model, and so the model space box they collide with
+	enum EntityKind
+	{
+		CollectableKind,
+		TriggerKind,
+		GoalKind,
+		BridgeKind,
+		EntityKindCount
+	};
+public:
+	LevelState(const LevelState&) = delete;
+	LevelState& operator=(const LevelState&) = delete;
+	virtual ~LevelState() = default;
+
+	static std::unique_ptr<LevelState> BuildHeadless(int levelNum, const ChunkStreamer::Settings& streamerSettings);
+
+	void Update(float playerX, float playerZ);
+	//Drops every streamed chunk and loads the ones around the spawn point again, as they were when the level was built
+	void ResetChunks();
+	const std::vector<LevelChunk*>& GetChunks() const noexcept;
+	size_t GetChunkBytes() const noexcept;
+	int GetLevelNum() const noexcept;
+	static std::string GetFileName(int levelNum, const char* suffix);
+	//Model in 3DObjects for a kind, the bridge is a built-in box and has none
+	static const wchar_t* GetModelName(EntityKind kind) noexcept;
+protected:
+	LevelState(int _levelNum, const ChunkStreamer::Settings& _streamerSettings);
+
+	void Parse();
+	void BuildChunks();
+	void LoadModelBounds();
+	void BuildEntities();
+	//The mesh drawn for the index-th entity of a kind, a headless level has none
+	virtual GameObject* GetMesh(EntityKind kind, size_t index) const noexcept;
+	static TransformComponent GetTransform(const LevelData::Marker& marker) noexcept;
+private:
+	Entity AddEntity(EntityKind kind, size_t index, const TransformComponent& transform, ColliderType colliderType);
+public:
+	Registry registry;
+	DirectX::XMFLOAT3 spawnPosition = { 0.0f, 0.0f, 0.0f };
+protected:
+	LevelData levelData;
+	std::unique_ptr<ChunkStreamer> pStreamer;
+	ChunkStreamer::Settings streamerSettings;
+
+	//Set from the meshes by Level, or from the model files by a headless level
+	Float3 modelMin[EntityKindCount];
+	Float3 modelMax[EntityKindCount];
+
+	int levelNum;
+};
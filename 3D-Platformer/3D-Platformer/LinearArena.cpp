@@ -0,0 +1,119 @@
+#include "LinearArena.h"
+#include "MemoryTracker.h"
+
+LinearArena::LinearArena(size_t _blockSize) :
+	blockSize(_blockSize)
+{
+}
+
+LinearArena::~LinearArena()
+{
+	Reset();
+	for (const Block& block : blocks)
+	{
+		MemoryTracker::Remove(MemoryTracker::LevelObjectCategory, block.size);
+		::operator delete(block.pData);
+	}
+}
+
+//Thread safe so a level's pools can share its arena across loader threads
+void* LinearArena::Allocate(size_t size, size_t alignment)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return AllocateUnlocked(size, alignment);
+}
+
+//Keeps the blocks so the next level reuses them without going back to the heap
+void LinearArena::Reset()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	//Finalisers are pushed to the front, so this destroys objects in reverse creation order
+	for (Finaliser* pFinaliser = pFinalisers; pFinaliser != nullptr; pFinaliser = pFinaliser->pNext)
+	{
+		pFinaliser->pDestroy(pFinaliser->pObject);
+	}
+	pFinalisers = nullptr;
+
+	currentBlock = 0;
+	currentOffset = 0;
+	allocationCount = 0;
+	usedBytes = 0;
+	peakBytes = 0;
+}
+
+size_t LinearArena::GetAllocationCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return allocationCount;
+}
+
+size_t LinearArena::GetUsedBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return usedBytes;
+}
+
+size_t LinearArena::GetPeakBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return peakBytes;
+}
+
+size_t LinearArena::GetCapacityBytes() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	size_t capacity = 0;
+	for (const Block& block : blocks)
+	{
+		capacity += block.size;
+	}
+	return capacity;
+}
+
+size_t LinearArena::GetBlockCount() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return blocks.size();
+}
+
+void* LinearArena::AllocateUnlocked(size_t size, size_t alignment)
+{
+	while (true)
+	{
+		if (currentBlock < blocks.size())
+		{
+			const Block& block = blocks[currentBlock];
+			const uintptr_t base = reinterpret_cast<uintptr_t>(block.pData);
+			const size_t alignedOffset = ((base + currentOffset + alignment - 1) & ~uintptr_t(alignment - 1)) - base;
+
+			if (alignedOffset + size <= block.size)
+			{
+				usedBytes += alignedOffset + size - currentOffset;
+				peakBytes = usedBytes > peakBytes ? usedBytes : peakBytes;
+				currentOffset = alignedOffset + size;
+				allocationCount++;
+				return block.pData + alignedOffset;
+			}
+
+			//Move on to the next block, the end of this one is wasted
+			usedBytes += block.size - currentOffset;
+			currentBlock++;
+			currentOffset = 0;
+			continue;
+		}
+
+		//Oversized allocations get a block of their own
+		const size_t newBlockSize = size + alignment > blockSize ? size + alignment : blockSize;
+		blocks.push_back({ static_cast<uint8_t*>(::operator new(newBlockSize)), newBlockSize });
+		MemoryTracker::Add(MemoryTracker::LevelObjectCategory, newBlockSize);
+	}
+}
+
+void LinearArena::AddFinaliser(void (*pDestroy)(void*), void* pObject)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	Finaliser* pFinaliser = static_cast<Finaliser*>(AllocateUnlocked(sizeof(Finaliser), alignof(Finaliser)));
+	*pFinaliser = { pDestroy, pObject, pFinalisers };
+	pFinalisers = pFinaliser;
+}
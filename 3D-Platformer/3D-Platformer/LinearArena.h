@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+//Bump allocator for data that lives as long as a level
+//Nothing is freed individually, Reset runs the destructors of created objects in reverse order and rewinds in one go
+class LinearArena
+{
+public:
+	static constexpr size_t defaultBlockSize = 256 * 1024;
+public:
+	LinearArena(size_t _blockSize = defaultBlockSize);
+	LinearArena(const LinearArena&) = delete;
+	LinearArena& operator=(const LinearArena&) = delete;
+	~LinearArena();
+
+	void* Allocate(size_t size, size_t alignment);
+	void Reset();
+
+	template<class T, class... Args>
+	T* Create(Args&&... args)
+	{
+		void* pMemory = Allocate(sizeof(T), alignof(T));
+		T* pObject = new (pMemory) T(std::forward<Args>(args)...);
+		AddFinaliser([](void* p) { static_cast<T*>(p)->~T(); }, pObject);
+		return pObject;
+	}
+
+	size_t GetAllocationCount() const;
+	size_t GetUsedBytes() const;
+	size_t GetPeakBytes() const;
+	size_t GetCapacityBytes() const;
+	size_t GetBlockCount() const;
+private:
+	struct Block
+	{
+		uint8_t* pData;
+		size_t size;
+	};
+
+	struct Finaliser
+	{
+		void (*pDestroy)(void*);
+		void* pObject;
+		Finaliser* pNext;
+	};
+private:
+	void* AllocateUnlocked(size_t size, size_t alignment);
+	void AddFinaliser(void (*pDestroy)(void*), void* pObject);
+private:
+	mutable std::mutex mutex;
+	size_t blockSize;
+	std::vector<Block> blocks;
+	size_t currentBlock = 0;
+	size_t currentOffset = 0;
+	Finaliser* pFinalisers = nullptr;
+
+	size_t allocationCount = 0;
+	size_t usedBytes = 0;
+	size_t peakBytes = 0;
+};
@@ -0,0 +1,202 @@
+#include "Lz4.h"
+#include <cstring>
+
+size_t Lz4::CompressBound(size_t srcSize) noexcept
+{
+	return srcSize + srcSize / 255 + 16;
+}
+
+void Lz4::Compress(const uint8_t* pSrc, size_t srcSize, std::vector<uint8_t>& dst)
+{
+	dst.clear();
+	dst.reserve(CompressBound(srcSize));
+
+	size_t anchor = 0;
+
+	//Inputs too short to hold a match are stored as a single run of literals
+	if (srcSize > matchFindLimit)
+	{
+		//Last position a match may start at and end at
+		const size_t matchStartLimit = srcSize - matchFindLimit;
+		const size_t matchEndLimit = srcSize - lastLiterals;
+
+		//Positions of previously seen 4 byte sequences, stored + 1 so 0 means empty
+		std::vector<uint32_t> table(size_t(1) << hashBits, 0u);
+
+		size_t ip = 0;
+		while (ip < matchStartLimit)
+		{
+			const uint32_t sequence = Read32(pSrc + ip);
+			const uint32_t h = Hash(sequence);
+			const size_t candidate = table[h];
+			table[h] = static_cast<uint32_t>(ip + 1);
+
+			if (candidate == 0 || ip - (candidate - 1) > maxOffset || Read32(pSrc + candidate - 1) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			size_t ref = candidate - 1;
+
+			//Extend the match backwards over pending literals
+			while (ip > anchor && ref > 0 && pSrc[ip - 1] == pSrc[ref - 1])
+			{
+				ip--;
+				ref--;
+			}
+
+			//Extend the match forwards
+			size_t matchLength = minMatch;
+			while (ip + matchLength < matchEndLimit && pSrc[ref + matchLength] == pSrc[ip + matchLength])
+			{
+				matchLength++;
+			}
+
+			//Emit sequence: token, literals, offset, match length
+			const size_t literalLength = ip - anchor;
+			const size_t matchCode = matchLength - minMatch;
+			dst.push_back(static_cast<uint8_t>(((literalLength < 15 ? literalLength : 15) << 4) | (matchCode < 15 ? matchCode : 15)));
+			if (literalLength >= 15)
+			{
+				WriteLength(dst, literalLength - 15);
+			}
+			dst.insert(dst.end(), pSrc + anchor, pSrc + ip);
+
+			const size_t offset = ip - ref;
+			dst.push_back(static_cast<uint8_t>(offset & 0xFF));
+			dst.push_back(static_cast<uint8_t>(offset >> 8));
+			if (matchCode >= 15)
+			{
+				WriteLength(dst, matchCode - 15);
+			}
+
+			ip += matchLength;
+			anchor = ip;
+		}
+	}
+
+	//Remaining bytes are written as literals with no match
+	const size_t literalLength = srcSize - anchor;
+	dst.push_back(static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4));
+	if (literalLength >= 15)
+	{
+		WriteLength(dst, literalLength - 15);
+	}
+	dst.insert(dst.end(), pSrc + anchor, pSrc + srcSize);
+}
+
+bool Lz4::Decompress(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst, size_t dstSize) noexcept
+{
+	size_t ip = 0;
+	size_t op = 0;
+
+	while (ip < srcSize)
+	{
+		const uint8_t token = pSrc[ip++];
+
+		//Literals
+		size_t literalLength = token >> 4;
+		if (literalLength == 15 && !ReadLength(pSrc, srcSize, ip, literalLength))
+		{
+			return false;
+		}
+		if (literalLength > srcSize - ip || literalLength > dstSize - op)
+		{
+			return false;
+		}
+		memcpy(pDst + op, pSrc + ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		//The last sequence has no match
+		if (ip == srcSize)
+		{
+			break;
+		}
+
+		//Match
+		if (srcSize - ip < 2)
+		{
+			return false;
+		}
+		const size_t offset = pSrc[ip] | (pSrc[ip + 1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > op)
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15 && !ReadLength(pSrc, srcSize, ip, matchLength))
+		{
+			return false;
+		}
+		matchLength += minMatch;
+		if (matchLength > dstSize - op)
+		{
+			return false;
+		}
+
+		//An overlapping match repeats the last offset bytes, so after copying them once
+		//the already written part of the match is doubled until the match is complete
+		const uint8_t* pMatch = pDst + op - offset;
+		if (offset >= matchLength)
+		{
+			memcpy(pDst + op, pMatch, matchLength);
+		}
+		else
+		{
+			memcpy(pDst + op, pMatch, offset);
+			size_t copied = offset;
+			while (copied < matchLength)
+			{
+				const size_t count = copied < matchLength - copied ? copied : matchLength - copied;
+				memcpy(pDst + op + copied, pDst + op, count);
+				copied += count;
+			}
+		}
+		op += matchLength;
+	}
+
+	return op == dstSize;
+}
+
+uint32_t Lz4::Read32(const uint8_t* p) noexcept
+{
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+uint32_t Lz4::Hash(uint32_t sequence) noexcept
+{
+	return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+//Write a length that has overflowed its 4 bit token field
+void Lz4::WriteLength(std::vector<uint8_t>& dst, size_t length)
+{
+	while (length >= 255)
+	{
+		dst.push_back(255);
+		length -= 255;
+	}
+	dst.push_back(static_cast<uint8_t>(length));
+}
+
+//Read the extra bytes of a length field, fails if it runs past the end of the input
+bool Lz4::ReadLength(const uint8_t* pSrc, size_t srcSize, size_t& ip, size_t& length) noexcept
+{
+	uint8_t b;
+	do
+	{
+		if (ip >= srcSize)
+		{
+			return false;
+		}
+		b = pSrc[ip++];
+		length += b;
+	} while (b == 255);
+	return true;
+}
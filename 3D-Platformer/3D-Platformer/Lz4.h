@@ -0,0 +1,24 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//Compressor and decompressor for the LZ4 block format (no frame header)
+class Lz4
+{
+public:
+	static size_t CompressBound(size_t srcSize) noexcept;
+	static void Compress(const uint8_t* pSrc, size_t srcSize, std::vector<uint8_t>& dst);
+	static bool Decompress(const uint8_t* pSrc, size_t srcSize, uint8_t* pDst, size_t dstSize) noexcept;
+private:
+	static uint32_t Read32(const uint8_t* p) noexcept;
+	static uint32_t Hash(uint32_t sequence) noexcept;
+	static void WriteLength(std::vector<uint8_t>& dst, size_t length);
+	static bool ReadLength(const uint8_t* pSrc, size_t srcSize, size_t& ip, size_t& length) noexcept;
+private:
+	static constexpr size_t minMatch = 4;
+	static constexpr size_t lastLiterals = 5;
+	static constexpr size_t matchFindLimit = 12;
+	static constexpr size_t maxOffset = 65535;
+	static constexpr unsigned int hashBits = 12;
+};
@@ -0,0 +1,150 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::string& path)
+{
+	Open(path);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		Close();
+		std::swap(pData, other.pData);
+		std::swap(size, other.size);
+#ifdef _WIN32
+		std::swap(hFile, other.hFile);
+		std::swap(hMapping, other.hMapping);
+#else
+		std::swap(fileDescriptor, other.fileDescriptor);
+#endif
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+	hFile = file;
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		Close();
+		return false;
+	}
+
+	//Map the whole file read only, pages are loaded by the OS on first access
+	hMapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (hMapping == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	pData = static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (pData == nullptr)
+	{
+		Close();
+		return false;
+	}
+	size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat = {};
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		Close();
+		return false;
+	}
+
+	void* pView = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	if (pView == MAP_FAILED)
+	{
+		Close();
+		return false;
+	}
+	pData = static_cast<const uint8_t*>(pView);
+	size = static_cast<size_t>(fileStat.st_size);
+#endif
+	return true;
+}
+
+void MappedFile::Close() noexcept
+{
+#ifdef _WIN32
+	if (pData != nullptr)
+	{
+		UnmapViewOfFile(pData);
+	}
+	if (hMapping != nullptr)
+	{
+		CloseHandle(hMapping);
+		hMapping = nullptr;
+	}
+	if (hFile != nullptr)
+	{
+		CloseHandle(hFile);
+		hFile = nullptr;
+	}
+#else
+	if (pData != nullptr)
+	{
+		munmap(const_cast<uint8_t*>(pData), size);
+	}
+	if (fileDescriptor >= 0)
+	{
+		close(fileDescriptor);
+		fileDescriptor = -1;
+	}
+#endif
+	pData = nullptr;
+	size = 0;
+}
+
+bool MappedFile::IsOpen() const noexcept
+{
+	return pData != nullptr;
+}
+
+const uint8_t* MappedFile::GetData() const noexcept
+{
+	return pData;
+}
+
+size_t MappedFile::GetSize() const noexcept
+{
+	return size;
+}
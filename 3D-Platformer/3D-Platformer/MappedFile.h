@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//Read only memory mapping of a whole file
+class MappedFile
+{
+public:
+	MappedFile() = default;
+	MappedFile(const std::string& path);
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+	~MappedFile();
+
+	bool Open(const std::string& path);
+	void Close() noexcept;
+	bool IsOpen() const noexcept;
+	const uint8_t* GetData() const noexcept;
+	size_t GetSize() const noexcept;
+private:
+	const uint8_t* pData = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	void* hFile = nullptr;
+	void* hMapping = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+};
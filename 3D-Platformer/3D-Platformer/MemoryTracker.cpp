@@ -0,0 +1,99 @@
+#include "MemoryTracker.h"
+#include <sstream>
+
+MemoryTracker MemoryTracker::tracker;
+
+static const char* const categoryNames[MemoryTracker::CategoryCount] =
+{
+	"level data", "chunks", "entities", "level objects", "rewind history", "batched instances",
+	"vertex buffers", "index buffers", "textures", "constant buffers"
+};
+
+void MemoryTracker::Add(Category category, size_t bytes) noexcept
+{
+	Counter& counter = tracker.counters[category];
+	const size_t total = counter.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+	counter.allocations.fetch_add(1, std::memory_order_relaxed);
+
+	size_t peak = counter.peakBytes.load(std::memory_order_relaxed);
+	while (total > peak && !counter.peakBytes.compare_exchange_weak(peak, total, std::memory_order_relaxed))
+	{
+	}
+}
+
+void MemoryTracker::Remove(Category category, size_t bytes) noexcept
+{
+	tracker.counters[category].bytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetBudget(Category category, size_t bytes) noexcept
+{
+	tracker.counters[category].budgetBytes.store(bytes, std::memory_order_relaxed);
+}
+
+MemoryTracker::Usage MemoryTracker::GetUsage(Category category) noexcept
+{
+	const Counter& counter = tracker.counters[category];
+	Usage usage;
+	usage.bytes = counter.bytes.load(std::memory_order_relaxed);
+	usage.peakBytes = counter.peakBytes.load(std::memory_order_relaxed);
+	usage.allocations = counter.allocations.load(std::memory_order_relaxed);
+	usage.budgetBytes = counter.budgetBytes.load(std::memory_order_relaxed);
+	return usage;
+}
+
+//Judged on the peak, so a budget broken between two reports is still caught
+bool MemoryTracker::IsOverBudget(Category category) noexcept
+{
+	const Usage usage = GetUsage(category);
+	return usage.budgetBytes != 0 && usage.peakBytes > usage.budgetBytes;
+}
+
+size_t MemoryTracker::GetTotalBytes(bool gpu) noexcept
+{
+	size_t total = 0;
+	for (int category = 0; category < CategoryCount; category++)
+	{
+		if (IsGpuCategory(Category(category)) == gpu)
+		{
+			total += tracker.counters[category].bytes.load(std::memory_order_relaxed);
+		}
+	}
+	return total;
+}
+
+void MemoryTracker::ResetPeaks() noexcept
+{
+	for (Counter& counter : tracker.counters)
+	{
+		counter.peakBytes.store(counter.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+}
+
+const char* MemoryTracker::GetCategoryName(Category category) noexcept
+{
+	return categoryNames[category];
+}
+
+bool MemoryTracker::IsGpuCategory(Category category) noexcept
+{
+	return category >= VertexBufferCategory;
+}
+
+std::string MemoryTracker::GetReport()
+{
+	std::ostringstream oss;
+	oss << "Memory: " << GetTotalBytes(false) << " CPU bytes, " << GetTotalBytes(true) << " GPU bytes\n";
+	for (int category = 0; category < CategoryCount; category++)
+	{
+		const Usage usage = GetUsage(Category(category));
+		oss << "  " << (IsGpuCategory(Category(category)) ? "GPU " : "CPU ") << categoryNames[category] << ": "
+			<< usage.bytes << " bytes, " << usage.peakBytes << " peak, " << usage.allocations << " allocations";
+		if (usage.budgetBytes != 0)
+		{
+			oss << ", budget " << usage.budgetBytes << (IsOverBudget(Category(category)) ? " OVER BUDGET" : "");
+		}
+		oss << "\n";
+	}
+	return oss.str();
+}
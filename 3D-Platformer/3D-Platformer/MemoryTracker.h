@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+
+//Bytes in use by each kind of memory the game owns
+//CPU memory is counted by the containers that hold it, through TrackedAllocator, and GPU memory by the bindables that create it
+class MemoryTracker
+{
+public:
+	enum Category
+	{
+		LevelDataCategory,
+		ChunkCategory,
+		EntityCategory,
+		LevelObjectCategory,
+		RewindCategory,
+		BatchCategory,
+		VertexBufferCategory,
+		IndexBufferCategory,
+		TextureCategory,
+		ConstantBufferCategory,
+		CategoryCount
+	};
+
+	struct Usage
+	{
+		size_t bytes;
+		size_t peakBytes;
+		uint64_t allocations;
+		//0 is no budget
+		size_t budgetBytes;
+	};
+public:
+	static void Add(Category category, size_t bytes) noexcept;
+	static void Remove(Category category, size_t bytes) noexcept;
+
+	//Going over a budget does not stop the allocation, it is flagged in the report so the budget or the content can be fixed
+	static void SetBudget(Category category, size_t bytes) noexcept;
+	static Usage GetUsage(Category category) noexcept;
+	static bool IsOverBudget(Category category) noexcept;
+	static size_t GetTotalBytes(bool gpu) noexcept;
+	static void ResetPeaks() noexcept;
+
+	static const char* GetCategoryName(Category category) noexcept;
+	static bool IsGpuCategory(Category category) noexcept;
+	//One line per category with its bytes, peak and budget
+	static std::string GetReport();
+private:
+	struct Counter
+	{
+		std::atomic<size_t> bytes = 0;
+		std::atomic<size_t> peakBytes = 0;
+		std::atomic<uint64_t> allocations = 0;
+		std::atomic<size_t> budgetBytes = 0;
+	};
+private:
+	constexpr MemoryTracker() = default;
+private:
+	static MemoryTracker tracker;													//Memory tracker singleton
+
+	Counter counters[CategoryCount];
+};
+
+//Standard library allocator that counts what it allocates under one category
+template<typename T, MemoryTracker::Category category>
+class TrackedAllocator
+{
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind
+	{
+		using other = TrackedAllocator<U, category>;
+	};
+public:
+	TrackedAllocator() noexcept = default;
+	template<typename U>
+	TrackedAllocator(const TrackedAllocator<U, category>&) noexcept
+	{
+	}
+
+	T* allocate(size_t count)
+	{
+		T* pMemory = static_cast<T*>(::operator new(count * sizeof(T)));
+		MemoryTracker::Add(category, count * sizeof(T));
+		return pMemory;
+	}
+
+	void deallocate(T* pMemory, size_t count) noexcept
+	{
+		MemoryTracker::Remove(category, count * sizeof(T));
+		::operator delete(pMemory);
+	}
+
+	template<typename U>
+	bool operator==(const TrackedAllocator<U, category>&) const noexcept
+	{
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const TrackedAllocator<U, category>&) const noexcept
+	{
+		return false;
+	}
+};
+
+template<typename T, MemoryTracker::Category category>
+using TrackedVector = std::vector<T, TrackedAllocator<T, category>>;
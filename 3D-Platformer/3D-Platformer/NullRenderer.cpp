@@ -0,0 +1,34 @@
+#include "NullRenderer.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "Systems.h"
+
+void NullRenderer::Publish(const LevelState& level, const PlayerPhysics& player, FrameStats& frameStats)
+{
+	PROFILE_SCOPE("Publish snapshot");
+	FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::PublishPhase);
+
+	tiles.clear();
+	for (const LevelChunk* pChunk : level.GetChunks())
+	{
+		tiles.insert(tiles.end(), pChunk->tiles.begin(), pChunk->tiles.end());
+	}
+
+	//The player and the colour box have no mesh here either, their draws are still sorted with the rest
+	//The box spins in place at the origin in the game, where it is drawn does not change the counts
+	WorldComponent playerWorld;
+	TransformSystem::CalculateWorld({ player.GetPosition(), { 0.0f, player.GetRotationY(), 0.0f }, { 1.0f, 1.0f, 1.0f } }, playerWorld);
+	WorldComponent boxWorld;
+	TransformSystem::CalculateWorld({ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } }, boxWorld);
+	objects.clear();
+	objects.push_back({ nullptr, playerWorld });
+	objects.push_back({ nullptr, boxWorld });
+	RenderQueue::Collect(level.registry, objects);
+
+	PerfCounters::Add(PerfCounters::DrawPacketCounter, GetPacketCount());
+}
+
+size_t NullRenderer::GetPacketCount() const noexcept
+{
+	return tiles.size() + objects.size();
+}
@@ -0,0 +1,21 @@
+#pragma once
+#include "FrameStats.h"
+#include "LevelState.h"
+#include "PlayerPhysics.h"
+#include "RenderQueue.h"
+#include "TileRecord.h"
+#include <vector>
+
+//The render side of a frame without a device, for the headless replays
+//Tiles and draws are copied out and sorted like Game::PublishSnapshot does, then counted instead of drawn
+class NullRenderer
+{
+public:
+	//Timed as the frame's publish phase, like the game's snapshot
+	void Publish(const LevelState& level, const PlayerPhysics& player, FrameStats& frameStats);
+	size_t GetPacketCount() const noexcept;
+private:
+	//Kept between frames to reuse their memory, as the game's snapshot buffers are
+	std::vector<TileRecord> tiles;
+	std::vector<DrawCommand> objects;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include <DirectXMath.h>
+#include <string>
+#include <vector>
+
+//Geometry and materials read from a Wavefront .obj file and its .mtl library, shared by every object loaded from a model
+//Parses text already in memory and needs no device, so the same code runs in the game, the tools and the benchmarks
+class ObjModel
+{
+public:
+	//Structure for vertex
+	struct Vertex
+	{
+		Vertex() {};
+		Vertex(
+			float x, float y, float z,
+			float u, float v) :
+			pos(x, y, z), texCoord(u, v) {}
+
+		DirectX::XMFLOAT3 pos;
+		DirectX::XMFLOAT2 texCoord;
+		DirectX::XMFLOAT3 normal;
+	};
+
+	//A run of faces drawn with one material
+	struct SurfaceMaterial
+	{
+		std::wstring matName;
+		int numOfFaces;
+	};
+
+	//Material structure
+	struct Material
+	{
+		std::wstring matName;
+		DirectX::XMFLOAT4 difColor;
+		bool transparent;
+	};
+public:
+	//Reads the vertices, faces and the name of the material library
+	void ParseObj(const std::wstring& objText);
+	//Reads the material library named by mtlFileName, after ParseObj
+	void ParseMtl(const std::wstring& mtlText);
+public:
+	std::vector<Vertex> vertices;
+	std::vector<unsigned short> indices;
+
+	std::vector<Material> materials;
+	std::vector<SurfaceMaterial> surfaceMaterials;
+
+	bool hasNormals = false;
+	bool hasTexture = false;
+	float totalFaces = 0.0f;
+
+	std::wstring mtlFileName;
+	std::wstring textureName;
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include "LinearArena.h"
+#include <memory>
+#include <mutex>
+
+//Pool of objects of one type, carved in slabs out of a level's arena
+//Destroyed objects go on a free list and their slots are reused, so chunks streaming in and out do not touch the heap
+template<class T>
+class ObjectPool
+{
+public:
+	static constexpr size_t objectsPerSlab = 256;
+
+	struct Deleter
+	{
+		ObjectPool* pPool;
+		void operator()(T* pObject) const
+		{
+			pPool->Destroy(pObject);
+		}
+	};
+	using Handle = std::unique_ptr<T, Deleter>;
+public:
+	ObjectPool(LinearArena& _arena) :
+		arena(_arena)
+	{
+	}
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template<class... Args>
+	Handle Create(Args&&... args)
+	{
+		void* pSlot = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (pFreeList == nullptr)
+			{
+				AddSlab();
+			}
+			pSlot = pFreeList;
+			pFreeList = pFreeList->pNext;
+
+			allocationCount++;
+			liveCount++;
+			peakLiveCount = liveCount > peakLiveCount ? liveCount : peakLiveCount;
+		}
+		return Handle(new (pSlot) T(std::forward<Args>(args)...), Deleter{ this });
+	}
+
+	void Destroy(T* pObject)
+	{
+		pObject->~T();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		FreeSlot* pSlot = reinterpret_cast<FreeSlot*>(pObject);
+		pSlot->pNext = pFreeList;
+		pFreeList = pSlot;
+		liveCount--;
+	}
+
+	size_t GetAllocationCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return allocationCount;
+	}
+
+	size_t GetLiveCount() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return liveCount;
+	}
+
+	size_t GetPeakBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return peakLiveCount * slotSize;
+	}
+
+	size_t GetCapacityBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return slabCount * objectsPerSlab * slotSize;
+	}
+private:
+	struct FreeSlot
+	{
+		FreeSlot* pNext;
+	};
+
+	//Slots hold either an object or a free list link, and are padded so every slot in a slab stays aligned
+	static constexpr size_t slotAlignment = alignof(T) > alignof(FreeSlot) ? alignof(T) : alignof(FreeSlot);
+	static constexpr size_t slotSize = ((sizeof(T) > sizeof(FreeSlot) ? sizeof(T) : sizeof(FreeSlot)) + slotAlignment - 1) & ~(slotAlignment - 1);
+
+	void AddSlab()
+	{
+		uint8_t* pSlab = static_cast<uint8_t*>(arena.Allocate(slotSize * objectsPerSlab, slotAlignment));
+		for (size_t i = objectsPerSlab; i-- > 0;)
+		{
+			FreeSlot* pSlot = reinterpret_cast<FreeSlot*>(pSlab + i * slotSize);
+			pSlot->pNext = pFreeList;
+			pFreeList = pSlot;
+		}
+		slabCount++;
+	}
+private:
+	LinearArena& arena;
+	mutable std::mutex mutex;
+	FreeSlot* pFreeList = nullptr;
+	size_t slabCount = 0;
+	size_t allocationCount = 0;
+	size_t liveCount = 0;
+	size_t peakLiveCount = 0;
+};
@@ -0,0 +1,114 @@
+#include "PerfCounters.h"
+#include <cstdio>
+
+PerfCounters PerfCounters::perfCounters;
+
+static const char* const counterNames[PerfCounters::CounterCount] =
+{
+	"draw_calls", "draw_packets", "binds", "triangles", "objects_updated", "collision_tests", "cbuffer_bytes", "allocations",
+	"files_read", "file_bytes", "chunks_loaded", "meshes_loaded", "textures_loaded", "levels_built"
+};
+
+static const char* const gaugeNames[PerfCounters::GaugeCount] =
+{
+	"frame_ms", "sim_ms", "render_ms", "entities", "loaded_chunks", "cpu_bytes", "gpu_bytes"
+};
+
+//Byte counts are kept as doubles too, printed whole rather than in the stream's default six digits
+static void WriteGauge(std::ostream& out, double value)
+{
+	char text[32];
+	snprintf(text, sizeof(text), "%.10g", value);
+	out << text;
+}
+
+void PerfCounters::Add(Counter counter, uint64_t amount) noexcept
+{
+	perfCounters.current[counter].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void PerfCounters::Set(Gauge gauge, double value) noexcept
+{
+	perfCounters.gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+void PerfCounters::EndFrame() noexcept
+{
+	for (int counter = 0; counter < CounterCount; counter++)
+	{
+		const uint64_t count = perfCounters.current[counter].exchange(0, std::memory_order_relaxed);
+		perfCounters.lastFrame[counter].store(count, std::memory_order_relaxed);
+		perfCounters.totals[counter].fetch_add(count, std::memory_order_relaxed);
+	}
+}
+
+uint64_t PerfCounters::GetLastFrame(Counter counter) noexcept
+{
+	return perfCounters.lastFrame[counter].load(std::memory_order_relaxed);
+}
+
+uint64_t PerfCounters::GetTotal(Counter counter) noexcept
+{
+	return perfCounters.totals[counter].load(std::memory_order_relaxed);
+}
+
+double PerfCounters::Get(Gauge gauge) noexcept
+{
+	return perfCounters.gauges[gauge].load(std::memory_order_relaxed);
+}
+
+const char* PerfCounters::GetName(Counter counter) noexcept
+{
+	return counterNames[counter];
+}
+
+const char* PerfCounters::GetName(Gauge gauge) noexcept
+{
+	return gaugeNames[gauge];
+}
+
+void PerfCounters::WriteCsvHeader(std::ostream& out)
+{
+	out << "frame";
+	for (const char* name : counterNames)
+	{
+		out << "," << name;
+	}
+	for (const char* name : gaugeNames)
+	{
+		out << "," << name;
+	}
+	out << "\n";
+}
+
+void PerfCounters::WriteCsvRow(std::ostream& out, uint64_t frameNumber)
+{
+	out << frameNumber;
+	for (int counter = 0; counter < CounterCount; counter++)
+	{
+		out << "," << GetLastFrame(Counter(counter));
+	}
+	for (int gauge = 0; gauge < GaugeCount; gauge++)
+	{
+		out << ",";
+		WriteGauge(out, Get(Gauge(gauge)));
+	}
+	out << "\n";
+}
+
+//The names are plain identifiers, so they need no escaping
+void PerfCounters::WriteJson(std::ostream& out, uint64_t frameNumber)
+{
+	out << "{\"frame\":" << frameNumber << ",\"counters\":{";
+	for (int counter = 0; counter < CounterCount; counter++)
+	{
+		out << (counter > 0 ? "," : "") << "\"" << counterNames[counter] << "\":" << GetLastFrame(Counter(counter));
+	}
+	out << "},\"gauges\":{";
+	for (int gauge = 0; gauge < GaugeCount; gauge++)
+	{
+		out << (gauge > 0 ? "," : "") << "\"" << gaugeNames[gauge] << "\":";
+		WriteGauge(out, Get(Gauge(gauge)));
+	}
+	out << "}}\n";
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+//Engine counters summed over a frame and gauges holding the latest value of something, readable from any thread
+//Adding to a counter is one relaxed atomic add, so they can be bumped on hot paths by any thread without locking
+//Counters are collected at the end of each simulation frame, work done by the render thread counts towards the frame it overlapped
+class PerfCounters
+{
+public:
+	enum Counter
+	{
+		DrawCallCounter,
+		DrawPacketCounter,
+		BindCounter,
+		TriangleCounter,
+		ObjectsUpdatedCounter,
+		CollisionTestCounter,
+		ConstantBufferBytesCounter,
+		AllocationCounter,
+		FileReadCounter,
+		FileBytesCounter,
+		ChunkLoadCounter,
+		MeshLoadCounter,
+		TextureLoadCounter,
+		LevelBuildCounter,
+		CounterCount
+	};
+
+	enum Gauge
+	{
+		FrameMillisecondsGauge,
+		SimMillisecondsGauge,
+		RenderMillisecondsGauge,
+		EntityGauge,
+		LoadedChunkGauge,
+		CpuBytesGauge,
+		GpuBytesGauge,
+		GaugeCount
+	};
+public:
+	static void Add(Counter counter, uint64_t amount = 1) noexcept;
+	static void Set(Gauge gauge, double value) noexcept;
+
+	//Moves the counts of the frame that just ended into the last frame values and starts counting the next one from zero
+	static void EndFrame() noexcept;
+	static uint64_t GetLastFrame(Counter counter) noexcept;
+	static uint64_t GetTotal(Counter counter) noexcept;
+	static double Get(Gauge gauge) noexcept;
+
+	static const char* GetName(Counter counter) noexcept;
+	static const char* GetName(Gauge gauge) noexcept;
+
+	//One row or one JSON object per frame, of the last frame's counters and the current gauges
+	static void WriteCsvHeader(std::ostream& out);
+	static void WriteCsvRow(std::ostream& out, uint64_t frameNumber);
+	static void WriteJson(std::ostream& out, uint64_t frameNumber);
+private:
+	constexpr PerfCounters() = default;
+private:
+	static PerfCounters perfCounters;												//Perf counters singleton
+
+	std::atomic<uint64_t> current[CounterCount] = {};
+	std::atomic<uint64_t> lastFrame[CounterCount] = {};
+	std::atomic<uint64_t> totals[CounterCount] = {};
+	std::atomic<double> gauges[GaugeCount] = {};
+};
@@ -0,0 +1,44 @@
+#include "PerfOverlay.h"
+#include "VirtualFileSystem.h"
+#include <DirectXColors.h>
+
+PerfOverlay::PerfOverlay(Graphics& gfx)
+{
+	const VirtualFile file = VirtualFileSystem::Open("Fonts\\Overlay.spritefont");
+	if (!file.IsValid())
+	{
+		OutputDebugStringA("Fonts\\Overlay.spritefont not found, the performance overlay is disabled\n");
+		return;
+	}
+
+	pSpriteBatch = std::make_unique<DirectX::SpriteBatch>(gfx.pContext);
+	pSpriteFont = std::make_unique<DirectX::SpriteFont>(gfx.pDevice, file.GetData(), file.GetSize());
+}
+
+bool PerfOverlay::IsLoaded() const noexcept
+{
+	return pSpriteFont != nullptr;
+}
+
+void PerfOverlay::Draw(Graphics& gfx, const char* text)
+{
+	if (!IsLoaded())
+	{
+		return;
+	}
+
+	//Widened into a buffer kept with the overlay, so drawing does not allocate
+	size_t length = 0;
+	for (; text[length] != '\0' && length < maxTextLength; length++)
+	{
+		wideText[length] = static_cast<wchar_t>(static_cast<unsigned char>(text[length]));
+	}
+	wideText[length] = L'\0';
+
+	pSpriteBatch->Begin();
+	pSpriteFont->DrawString(pSpriteBatch.get(), wideText, DirectX::XMFLOAT2(8.0f, 8.0f), DirectX::Colors::White);
+	pSpriteBatch->End();
+
+	//SpriteBatch leaves its own blend, depth and rasterizer state bound
+	gfx.RestoreState();
+}
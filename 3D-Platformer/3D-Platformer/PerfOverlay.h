@@ -0,0 +1,24 @@
+#pragma once
+#include "Graphics.h"
+#include "SpriteBatch.h"
+#include "SpriteFont.h"
+#include <memory>
+
+//Text drawn over the frame with DirectXTK, every line goes into one sprite batch so the whole overlay is a single draw
+//The font is a .spritefont made with DirectXTK's MakeSpriteFont tool, without it the overlay draws nothing
+class PerfOverlay
+{
+public:
+	static constexpr size_t maxTextLength = 2048;
+public:
+	PerfOverlay(Graphics& gfx);
+	PerfOverlay(const PerfOverlay&) = delete;
+	PerfOverlay& operator=(const PerfOverlay&) = delete;
+	bool IsLoaded() const noexcept;
+	//ASCII text, lines split by '\n', longer text is cut off
+	void Draw(Graphics& gfx, const char* text);
+private:
+	std::unique_ptr<DirectX::SpriteBatch> pSpriteBatch;
+	std::unique_ptr<DirectX::SpriteFont> pSpriteFont;
+	wchar_t wideText[maxTextLength + 1];
+};
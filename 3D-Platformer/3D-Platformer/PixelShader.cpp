@@ -1,12 +1,11 @@
 #include "PixelShader.h"
+#include "VirtualFileSystem.h"
 
 PixelShader::PixelShader(Graphics& gfx, const std::wstring& path)
 {
-	//Create pixel shader
-	ID3DBlob* pBlob;
-	D3DReadFileToBlob(path.c_str(), &pBlob);
-	GetDevice(gfx)->CreatePixelShader(pBlob->GetBufferPointer(), pBlob->GetBufferSize(), nullptr, &pPixelShader);
-	pBlob->Release();
+	//Create pixel shader directly from the file data
+	const VirtualFile file = VirtualFileSystem::Open(path);
+	GetDevice(gfx)->CreatePixelShader(file.GetData(), file.GetSize(), nullptr, &pPixelShader);
 }
 
 PixelShader::~PixelShader()
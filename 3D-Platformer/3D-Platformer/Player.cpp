@@ -144,7 +144,7 @@ Player::Player(Graphics& gfx, float _x, float _y, float _z)
 	}
 
 	//Bind transform buffer
-	AddBind(std::make_unique<TransformCbuf>(gfx, *this));
+	AddBind(std::make_unique<TransformCbuf>(gfx));
 
 	//Model deformation transform (Instance)
 	DirectX::XMStoreFloat3x3(
@@ -160,98 +160,11 @@ Player::Player(Graphics& gfx, float _x, float _y, float _z)
 	}
 
 	CreateBoundingBox(verticePositions);
-	CalculateAABB(GetTransformXM());
-}
-
-void Player::SetPlayerInput(float _horizontal, float _verticle)
-{
-	float rotation = yRot;
-
-	DirectX::XMFLOAT2 normalisedVector = DirectX::XMFLOAT2(std::sinf(rotation), std::cosf(rotation));
-	
-	float verticleX = normalisedVector.x * _verticle * speed;
-	float verticleZ = normalisedVector.y * _verticle * speed;
-
-	float horizontalX = normalisedVector.y * _horizontal * speed;
-	float horizontalZ = normalisedVector.x * -_horizontal * speed;
-
-	xVel = verticleX + horizontalX;
-	zVel = verticleZ + horizontalZ;
-}
-
-void Player::Jump()
-{
-	if (grounded)
-	{
-		yVel = 5.0f;
-		grounded = false;
-	}
-}
-
-void Player::SetGrounded(bool _grounded)
-{
-	grounded = _grounded;
-}
-
-void Player::SetVelocity(float _xVel, float _yVel, float _zVel)
-{
-	xVel = _xVel;
-	yVel = _yVel;
-	zVel = _zVel;
-}
-
-void Player::SetSpawnPosition(float _x, float _y, float _z)
-{
-	spawnX = _x;
-	spawnY = _y;
-	spawnZ = _z;
-}
-
-void Player::MovePosition(float _x, float _y, float _z)
-{
-	xPos += _x;
-	yPos += _y;
-	zPos += _z;
-
-	CalculateAABB(GetTransformXM());
-}
-
-void Player::SetRotationY(float angle)
-{
-	yRot += angle * rotationSpeed;
-}
-
-void Player::ApplyGravity(float dt)
-{
-	yVel -= gravity * dt;
+	MarkTransformDirty();
 }
 
 void Player::Update(float dt) noexcept
 {
-	if (xVel != 0.0f || yVel != 0.0f || zVel != 0.0f)
-	{
-		xPos += xVel * dt;
-		yPos += yVel * dt;
-		zPos += zVel * dt;
-	}
-
-	CalculateAABB(GetTransformXM());
-
-	//Respawn
-	if (yPos < 0)
-	{
-		xPos = spawnX;
-		yPos = spawnY;
-		zPos = spawnZ;
-
-		xVel = 0.0f;
-		yVel = 0.0f;
-		zVel = 0.0f;
-
-		xRot = 0.0f;
-		yRot = 0.0f;
-		zRot = 0.0f;
-	}
 }
 
 DirectX::XMMATRIX Player::GetTransformXM() const noexcept
@@ -260,10 +173,3 @@ DirectX::XMMATRIX Player::GetTransformXM() const noexcept
 		DirectX::XMMatrixRotationRollPitchYaw(xRot, yRot, zRot) *
 		DirectX::XMMatrixTranslation(xPos, yPos, zPos);
 }
-
-DirectX::XMVECTOR Player::GetVelocity()
-{
-	return DirectX::XMVectorSet(xVel, yVel, zVel, 0.0f);
-}
-
-
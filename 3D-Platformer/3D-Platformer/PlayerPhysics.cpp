@@ -0,0 +1,139 @@
+#include "PlayerPhysics.h"
+#include "Systems.h"
+#include <cmath>
+
+void PlayerPhysics::SetPlayerInput(float _horizontal, float _verticle) noexcept
+{
+	const float sinRotation = std::sin(yRot);
+	const float cosRotation = std::cos(yRot);
+
+	float verticleX = sinRotation * _verticle * speed;
+	float verticleZ = cosRotation * _verticle * speed;
+
+	float horizontalX = cosRotation * _horizontal * speed;
+	float horizontalZ = sinRotation * -_horizontal * speed;
+
+	velocity.x = verticleX + horizontalX;
+	velocity.z = verticleZ + horizontalZ;
+}
+
+void PlayerPhysics::Jump() noexcept
+{
+	if (grounded)
+	{
+		velocity.y = 5.0f;
+		grounded = false;
+	}
+}
+
+void PlayerPhysics::SetGrounded(bool _grounded) noexcept
+{
+	grounded = _grounded;
+}
+
+void PlayerPhysics::SetVelocity(const Float3& _velocity) noexcept
+{
+	velocity = _velocity;
+}
+
+void PlayerPhysics::SetSpawnPosition(const Float3& _spawn) noexcept
+{
+	spawn = _spawn;
+}
+
+void PlayerPhysics::SetPosition(const Float3& _position) noexcept
+{
+	position = _position;
+	boundsDirty = true;
+}
+
+void PlayerPhysics::MovePosition(const Float3& offset) noexcept
+{
+	position.x += offset.x;
+	position.y += offset.y;
+	position.z += offset.z;
+	boundsDirty = true;
+}
+
+void PlayerPhysics::SetRotationY(float angle) noexcept
+{
+	yRot += angle * rotationSpeed;
+	boundsDirty = true;
+}
+
+void PlayerPhysics::ApplyGravity(float dt) noexcept
+{
+	velocity.y -= gravity * dt;
+}
+
+void PlayerPhysics::Update(float dt) noexcept
+{
+	if (velocity.x != 0.0f || velocity.y != 0.0f || velocity.z != 0.0f)
+	{
+		position.x += velocity.x * dt;
+		position.y += velocity.y * dt;
+		position.z += velocity.z * dt;
+		boundsDirty = true;
+	}
+
+	//Respawn
+	if (position.y < 0)
+	{
+		position = spawn;
+		velocity = {};
+		yRot = 0.0f;
+		boundsDirty = true;
+	}
+}
+
+const Float3& PlayerPhysics::GetPosition() const noexcept
+{
+	return position;
+}
+
+float PlayerPhysics::GetRotationY() const noexcept
+{
+	return yRot;
+}
+
+const Float3& PlayerPhysics::GetVelocity() const noexcept
+{
+	return velocity;
+}
+
+bool PlayerPhysics::IsGrounded() const noexcept
+{
+	return grounded;
+}
+
+PlayerPhysics::State PlayerPhysics::GetState() const noexcept
+{
+	return { position, velocity, yRot, grounded };
+}
+
+void PlayerPhysics::SetState(const State& state) noexcept
+{
+	position = state.position;
+	velocity = state.velocity;
+	yRot = state.yRot;
+	grounded = state.grounded;
+	boundsDirty = true;
+}
+
+const BoundsComponent& PlayerPhysics::GetBounds() noexcept
+{
+	if (boundsDirty)
+	{
+		WorldComponent world;
+		TransformSystem::CalculateWorld({ position, { 0.0f, yRot, 0.0f }, { 1.0f, 1.0f, 1.0f } }, world);
+		TransformSystem::CalculateWorldBounds(world, bounds);
+		boundsDirty = false;
+	}
+	return bounds;
+}
+
+Float3 PlayerPhysics::GetCenter() noexcept
+{
+	const BoundsComponent& box = GetBounds();
+	return { (box.worldMin.x + box.worldMax.x) * 0.5f, (box.worldMin.y + box.worldMax.y) * 0.5f, (box.worldMin.z + box.worldMax.z) * 0.5f };
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "Components.h"
+
+//The player's movement, a unit box moved by its input and gravity and pushed out of what it collides with
+//Kept apart from the Player mesh so the simulation runs without a device, the mesh is moved to it after each step
+class PlayerPhysics
+{
+public:
+	//Everything a step changes, kept by snapshots
+	struct State
+	{
+		Float3 position;
+		Float3 velocity;
+		float yRot;
+		bool grounded;
+	};
+public:
+	void SetPlayerInput(float _horizontal, float _verticle) noexcept;
+	void SetVelocity(const Float3& _velocity) noexcept;
+	void SetSpawnPosition(const Float3& _spawn) noexcept;
+	void SetPosition(const Float3& _position) noexcept;
+	void MovePosition(const Float3& offset) noexcept;
+	void SetRotationY(float angle) noexcept;
+	void ApplyGravity(float dt) noexcept;
+	void Jump() noexcept;
+	void SetGrounded(bool _grounded) noexcept;
+	void Update(float dt) noexcept;
+
+	const Float3& GetPosition() const noexcept;
+	float GetRotationY() const noexcept;
+	const Float3& GetVelocity() const noexcept;
+	bool IsGrounded() const noexcept;
+	State GetState() const noexcept;
+	void SetState(const State& state) noexcept;
+	//World box around the rotated box, rebuilt after the player moves or turns
+	const BoundsComponent& GetBounds() noexcept;
+	Float3 GetCenter() noexcept;
+private:
+	//Physics
+	bool grounded = false;
+	float gravity = 9.8f;
+	float speed = 4.0f;
+	float rotationSpeed = 1.5f;
+
+	Float3 spawn;
+	Float3 position;
+	Float3 velocity;
+	float yRot = 0.0f;
+
+	//The world box starts as the model box at the origin and is recalculated whenever boundsDirty is set
+	BoundsComponent bounds = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f }, { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } };
+	bool boundsDirty = true;
+};
@@ -0,0 +1,144 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+Profiler Profiler::profiler;
+
+thread_local Profiler::ThreadBuffer* Profiler::pThreadBuffer = nullptr;
+
+uint64_t Profiler::Now() noexcept
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end) noexcept
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+	const uint64_t index = buffer.count.load(std::memory_order_relaxed);
+	Event& event = buffer.events[index % eventsPerThread];
+	event.name.store(name, std::memory_order_relaxed);
+	event.start.store(start, std::memory_order_relaxed);
+	event.end.store(end, std::memory_order_relaxed);
+	buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	GetThreadBuffer().threadName.store(name, std::memory_order_relaxed);
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer()
+{
+	if (pThreadBuffer == nullptr)
+	{
+		auto pBuffer = std::make_unique<ThreadBuffer>();
+		std::lock_guard<std::mutex> lock(profiler.mutex);
+		pBuffer->threadId = static_cast<uint32_t>(profiler.buffers.size() + 1);
+		pThreadBuffer = pBuffer.get();
+		profiler.buffers.push_back(std::move(pBuffer));
+	}
+	return *pThreadBuffer;
+}
+
+//Zone names are string literals, only quotes and backslashes need escaping
+static void WriteJsonString(std::ostream& out, const char* text)
+{
+	out << '"';
+	for (const char* p = text; *p != '\0'; p++)
+	{
+		if (*p == '"' || *p == '\\')
+		{
+			out << '\\';
+		}
+		out << *p;
+	}
+	out << '"';
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path)
+{
+	struct Zone
+	{
+		const char* name;
+		uint64_t start;
+		uint64_t end;
+	};
+
+	struct ThreadZones
+	{
+		uint32_t threadId;
+		const char* threadName;
+		std::vector<Zone> zones;
+	};
+
+	//Copy the zones out first so the file is written without holding the lock
+	std::vector<ThreadZones> threads;
+	{
+		std::lock_guard<std::mutex> lock(profiler.mutex);
+		for (const auto& pBuffer : profiler.buffers)
+		{
+			ThreadZones thread = { pBuffer->threadId, pBuffer->threadName.load(std::memory_order_relaxed), {} };
+
+			const uint64_t count = pBuffer->count.load(std::memory_order_acquire);
+			const uint64_t first = count > eventsPerThread ? count - eventsPerThread : 0;
+			thread.zones.reserve(static_cast<size_t>(count - first));
+			for (uint64_t i = first; i < count; i++)
+			{
+				const Event& event = pBuffer->events[i % eventsPerThread];
+				thread.zones.push_back({ event.name.load(std::memory_order_relaxed), event.start.load(std::memory_order_relaxed), event.end.load(std::memory_order_relaxed) });
+			}
+
+			//The oldest zones may have been overwritten while they were copied
+			const uint64_t countAfter = pBuffer->count.load(std::memory_order_acquire);
+			const uint64_t firstValid = countAfter > eventsPerThread ? countAfter - eventsPerThread : 0;
+			if (firstValid > first)
+			{
+				const size_t overwritten = static_cast<size_t>((std::min)(firstValid - first, count - first));
+				thread.zones.erase(thread.zones.begin(), thread.zones.begin() + overwritten);
+			}
+			threads.push_back(std::move(thread));
+		}
+	}
+
+	uint64_t origin = UINT64_MAX;
+	for (const ThreadZones& thread : threads)
+	{
+		for (const Zone& zone : thread.zones)
+		{
+			origin = (std::min)(origin, zone.start);
+		}
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		return false;
+	}
+
+	//Timestamps are microseconds from the first zone
+	out << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	const char* separator = "\n";
+	for (const ThreadZones& thread : threads)
+	{
+		if (thread.threadName != nullptr)
+		{
+			out << separator << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << thread.threadId << ",\"args\":{\"name\":";
+			WriteJsonString(out, thread.threadName);
+			out << "}}";
+			separator = ",\n";
+		}
+
+		for (const Zone& zone : thread.zones)
+		{
+			out << separator << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.threadId
+				<< ",\"ts\":" << (zone.start - origin) / 1000.0 << ",\"dur\":" << (zone.end - zone.start) / 1000.0 << ",\"name\":";
+			WriteJsonString(out, zone.name);
+			out << '}';
+			separator = ",\n";
+		}
+	}
+	out << "\n]}\n";
+	return static_cast<bool>(out);
+}
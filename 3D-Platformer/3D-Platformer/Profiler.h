@@ -0,0 +1,86 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Build with PROFILER_ENABLED defined as 0 to compile every zone out
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+//Records named zones of code into a ring per thread and writes them out in Chrome's trace event format
+//Open the file in Perfetto (ui.perfetto.dev) or chrome://tracing, zones nest by time on each thread
+//Recording takes no locks, a thread only locks once to register its ring the first time it records
+class Profiler
+{
+public:
+	//Zones kept per thread, older zones are overwritten
+	static constexpr size_t eventsPerThread = 32768;
+public:
+	static uint64_t Now() noexcept;
+	static void Record(const char* name, uint64_t start, uint64_t end) noexcept;
+	//Shown as the thread's name in the trace, name must outlive the program
+	static void SetThreadName(const char* name);
+	static bool WriteChromeTrace(const std::string& path);
+private:
+	//Fields are atomic so the trace can be written while other threads record, a zone overwritten meanwhile is dropped
+	struct Event
+	{
+		std::atomic<const char*> name;
+		std::atomic<uint64_t> start;
+		std::atomic<uint64_t> end;
+	};
+
+	struct ThreadBuffer
+	{
+		uint32_t threadId = 0;
+		std::atomic<const char*> threadName = nullptr;
+		std::atomic<uint64_t> count = 0;
+		Event events[eventsPerThread];
+	};
+private:
+	Profiler() = default;
+	static ThreadBuffer& GetThreadBuffer();
+private:
+	static Profiler profiler;														//Profiler singleton
+	static thread_local ThreadBuffer* pThreadBuffer;
+
+	//Rings are kept after their thread exits so its zones still appear in the trace
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+//Records the time from its construction to its destruction as a zone, use through PROFILE_SCOPE
+class ProfileScope
+{
+public:
+	ProfileScope(const char* _name) noexcept :
+		name(_name),
+		start(Profiler::Now())
+	{
+	}
+	~ProfileScope()
+	{
+		Profiler::Record(name, start, Profiler::Now());
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	const char* name;
+	uint64_t start;
+};
+
+#if PROFILER_ENABLED
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+//Zone from here to the end of the enclosing scope, name must outlive the program, such as a string literal
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::SetThreadName(name)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_THREAD(name)
+#endif
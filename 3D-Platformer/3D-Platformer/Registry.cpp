@@ -0,0 +1,71 @@
+#include "Registry.h"
+
+Entity Registry::Create()
+{
+	if (!freeEntities.empty())
+	{
+		const Entity entity = freeEntities.back();
+		freeEntities.pop_back();
+		return entity;
+	}
+	return nextEntity++;
+}
+
+void Registry::Destroy(Entity entity)
+{
+	transforms.Remove(entity);
+	worlds.Remove(entity);
+	bounds.Remove(entity);
+	renderables.Remove(entity);
+	colliders.Remove(entity);
+	animators.Remove(entity);
+	triggers.Remove(entity);
+	freeEntities.push_back(entity);
+}
+
+void Registry::Clear() noexcept
+{
+	transforms.Clear();
+	worlds.Clear();
+	bounds.Clear();
+	renderables.Clear();
+	colliders.Clear();
+	animators.Clear();
+	triggers.Clear();
+	freeEntities.clear();
+	dirtyEntities.clear();
+	dirtyFlags.clear();
+	nextEntity = 0;
+}
+
+size_t Registry::GetEntityCount() const noexcept
+{
+	return nextEntity - freeEntities.size();
+}
+
+void Registry::MarkDirty(Entity entity)
+{
+	if (entity >= dirtyFlags.size())
+	{
+		dirtyFlags.resize(entity + 1, 0);
+	}
+	if (dirtyFlags[entity] == 0)
+	{
+		dirtyFlags[entity] = 1;
+		dirtyEntities.push_back(entity);
+	}
+}
+
+const std::vector<Entity>& Registry::GetDirtyEntities() const noexcept
+{
+	return dirtyEntities;
+}
+
+void Registry::ClearDirty() noexcept
+{
+	for (const Entity entity : dirtyEntities)
+	{
+		dirtyFlags[entity] = 0;
+	}
+	dirtyEntities.clear();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "ComponentArray.h"
+#include "Components.h"
+#include "TransformBatch.h"
+#include <vector>
+
+//Owns the entities of a level and one packed array per component type
+//Entities are only ids, destroyed ids are reused
+//Whatever changes a transform marks the entity dirty, and only dirty entities have their world matrix and bounds rebuilt
+class Registry
+{
+public:
+	Registry() = default;
+	Registry(const Registry&) = delete;
+	Registry& operator=(const Registry&) = delete;
+
+	Entity Create();
+	void Destroy(Entity entity);
+	void Clear() noexcept;
+	size_t GetEntityCount() const noexcept;
+
+	void MarkDirty(Entity entity);
+	const std::vector<Entity>& GetDirtyEntities() const noexcept;
+	void ClearDirty() noexcept;
+public:
+	ComponentArray<TransformComponent> transforms;
+	ComponentArray<WorldComponent> worlds;
+	ComponentArray<BoundsComponent> bounds;
+	ComponentArray<RenderableComponent> renderables;
+	ComponentArray<ColliderComponent> colliders;
+	ComponentArray<AnimatorComponent> animators;
+	ComponentArray<TriggerComponent> triggers;
+
+	//Scratch space for TransformSystem, kept here so its arrays are only grown, never reallocated each frame
+	TransformBatch transformBatch;
+	std::vector<Entity> batchEntities;
+private:
+	Entity nextEntity = 0;
+	std::vector<Entity> freeEntities;
+
+	//Each entity is listed once per frame however often it moves
+	std::vector<Entity> dirtyEntities;
+	std::vector<uint8_t> dirtyFlags;
+};
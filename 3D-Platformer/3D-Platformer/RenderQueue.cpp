@@ -0,0 +1,28 @@
+#include "RenderQueue.h"
+#include "Registry.h"
+#include <algorithm>
+
+void RenderQueue::Collect(const Registry& registry, std::vector<DrawCommand>& drawList)
+{
+	for (size_t i = 0; i < registry.renderables.GetSize(); i++)
+	{
+		const RenderableComponent& renderable = registry.renderables.GetAt(i);
+		if (!renderable.visible)
+		{
+			continue;
+		}
+
+		if (const WorldComponent* pWorld = registry.worlds.Find(registry.renderables.GetEntityAt(i)))
+		{
+			drawList.push_back({ renderable.pMesh, *pWorld });
+		}
+	}
+
+	Sort(drawList);
+}
+
+void RenderQueue::Sort(std::vector<DrawCommand>& drawList)
+{
+	std::sort(drawList.begin(), drawList.end(),
+		[](const DrawCommand& a, const DrawCommand& b) { return a.pMesh < b.pMesh; });
+}
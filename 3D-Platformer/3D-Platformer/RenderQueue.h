@@ -0,0 +1,24 @@
+#pragma once
+#include "Components.h"
+#include <vector>
+
+class GameObject;
+class Registry;
+
+//A mesh and the world matrix to draw it with, copied out of the simulation so it can be drawn on another thread
+struct DrawCommand
+{
+	const GameObject* pMesh;
+	WorldComponent world;
+};
+
+//Collects and orders the draws of a frame, apart from RenderSystem as it needs no device
+class RenderQueue
+{
+public:
+	//Adds the visible renderables to whatever is already in the list, such as the player, then sorts the whole list
+	//Headless levels have no meshes, their draws are still collected so the null renderer handles as many as the game
+	static void Collect(const Registry& registry, std::vector<DrawCommand>& drawList);
+	//Draws of the same mesh next to each other
+	static void Sort(std::vector<DrawCommand>& drawList);
+};
@@ -0,0 +1,35 @@
+#include "RenderSystem.h"
+#include "GameObject.h"
+
+void RenderSystem::Draw(Graphics& gfx, const std::vector<DrawCommand>& drawList)
+{
+	for (const DrawCommand& command : drawList)
+	{
+		if (command.pMesh == nullptr)
+		{
+			continue;
+		}
+
+		const WorldComponent& world = command.world;
+		const DirectX::XMFLOAT4X4 worldMatrix(
+			world.axisX.x, world.axisX.y, world.axisX.z, 0.0f,
+			world.axisY.x, world.axisY.y, world.axisY.z, 0.0f,
+			world.axisZ.x, world.axisZ.y, world.axisZ.z, 0.0f,
+			world.translation.x, world.translation.y, world.translation.z, 1.0f);
+		command.pMesh->Draw(gfx, DirectX::XMLoadFloat4x4(&worldMatrix));
+	}
+}
+
+//Object transforms have no projection, so the last column is dropped
+WorldComponent RenderSystem::ToWorld(DirectX::FXMMATRIX matrix) noexcept
+{
+	DirectX::XMFLOAT4X4 stored;
+	DirectX::XMStoreFloat4x4(&stored, matrix);
+
+	WorldComponent world;
+	world.axisX = { stored._11, stored._12, stored._13 };
+	world.axisY = { stored._21, stored._22, stored._23 };
+	world.axisZ = { stored._31, stored._32, stored._33 };
+	world.translation = { stored._41, stored._42, stored._43 };
+	return world;
+}
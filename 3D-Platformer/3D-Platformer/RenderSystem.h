@@ -0,0 +1,13 @@
+#pragma once
+#include "Graphics.h"
+#include "Registry.h"
+#include "RenderQueue.h"
+#include <vector>
+
+//Draws a list from RenderQueue::Collect, each mesh with its entity's cached world matrix
+class RenderSystem
+{
+public:
+	static void Draw(Graphics& gfx, const std::vector<DrawCommand>& drawList);
+	static WorldComponent ToWorld(DirectX::FXMMATRIX matrix) noexcept;
+};
@@ -0,0 +1,216 @@
+#include "RewindBuffer.h"
+#include <algorithm>
+#include <cstring>
+
+//Changed bytes this close together are sent as one run, a run's header costs more than the few unchanged bytes between them
+static constexpr size_t runHeaderBytes = 2 * sizeof(uint16_t);
+
+RewindBuffer::RewindBuffer(size_t _byteCapacity, size_t _frameCapacity, uint32_t _keyframeInterval) :
+	byteCapacity((std::min)(_byteCapacity, size_t(UINT32_MAX))),
+	frameCapacity((std::max)(_frameCapacity, size_t(1))),
+	keyframeInterval((std::max)(_keyframeInterval, 1u))
+{}
+
+//The buffers are sized on the first reset and kept for every level after it
+void RewindBuffer::Reset(size_t _stateSize)
+{
+	stateSize = _stateSize;
+	firstRecord = 0;
+	recordCount = 0;
+	writeOffset = 0;
+	usedBytes = 0;
+	keyframeDistance = 0;
+	hasKeyframe = false;
+
+	bytes.resize(byteCapacity);
+	records.resize(frameCapacity);
+	keyframe.resize(stateSize);
+	scratch.resize(stateSize);
+}
+
+void RewindBuffer::Capture(const uint8_t* pState)
+{
+	if (stateSize == 0 || stateSize * 2 > byteCapacity)
+	{
+		return;
+	}
+
+	uint32_t deltaSize = 0;
+	if (hasKeyframe && keyframeDistance + 1 < keyframeInterval && EncodeDelta(pState, deltaSize) &&
+		Append(scratch.data(), deltaSize, keyframeDistance + 1))
+	{
+		keyframeDistance++;
+		return;
+	}
+
+	memcpy(keyframe.data(), pState, stateSize);
+	Append(keyframe.data(), uint32_t(stateSize), 0);
+	keyframeDistance = 0;
+	hasKeyframe = true;
+}
+
+bool RewindBuffer::Restore(size_t framesBack, uint8_t* pState) const
+{
+	if (framesBack >= recordCount)
+	{
+		return false;
+	}
+
+	const Record& record = GetRecord(framesBack);
+	const Record& key = GetRecord(framesBack + record.keyframeDistance);
+	memcpy(pState, bytes.data() + key.offset, stateSize);
+
+	const uint8_t* pRun = bytes.data() + record.offset;
+	const uint8_t* pEnd = pRun + (record.keyframeDistance > 0 ? record.size : 0);
+	size_t position = 0;
+	while (pRun < pEnd)
+	{
+		uint16_t unchanged, changed;
+		memcpy(&unchanged, pRun, sizeof(uint16_t));
+		memcpy(&changed, pRun + sizeof(uint16_t), sizeof(uint16_t));
+		pRun += runHeaderBytes;
+		position += unchanged;
+		for (size_t i = 0; i < changed; i++)
+		{
+			pState[position + i] ^= pRun[i];
+		}
+		pRun += changed;
+		position += changed;
+	}
+	return true;
+}
+
+//The keyframe of the frame carried on from may be gone with the dropped frames, so the next capture is a keyframe
+void RewindBuffer::Truncate(size_t frames)
+{
+	for (frames = (std::min)(frames, recordCount); frames > 0; frames--)
+	{
+		usedBytes -= GetRecord(0).size;
+		recordCount--;
+	}
+	writeOffset = recordCount > 0 ? GetRecord(0).offset + GetRecord(0).size : 0;
+	hasKeyframe = false;
+}
+
+size_t RewindBuffer::GetFrameCount() const noexcept
+{
+	return recordCount;
+}
+
+size_t RewindBuffer::GetUsedBytes() const noexcept
+{
+	return usedBytes;
+}
+
+bool RewindBuffer::EncodeDelta(const uint8_t* pState, uint32_t& size)
+{
+	const uint8_t* pKey = keyframe.data();
+	size = 0;
+	size_t position = 0;
+	while (position < stateSize)
+	{
+		size_t start = position;
+		while (start < stateSize && start - position < UINT16_MAX && pState[start] == pKey[start])
+		{
+			start++;
+		}
+		if (start == stateSize)
+		{
+			break;
+		}
+
+		//Extend the run over short gaps of unchanged bytes
+		size_t end = start;
+		while (end < stateSize && end - start < UINT16_MAX)
+		{
+			if (pState[end] != pKey[end])
+			{
+				end++;
+				continue;
+			}
+
+			size_t gap = 0;
+			while (end + gap < stateSize && gap < runHeaderBytes && pState[end + gap] == pKey[end + gap])
+			{
+				gap++;
+			}
+			if (gap == runHeaderBytes || end + gap == stateSize)
+			{
+				break;
+			}
+			end = (std::min)(end + gap, start + UINT16_MAX);
+		}
+
+		const uint16_t unchanged = uint16_t(start - position);
+		const uint16_t changed = uint16_t(end - start);
+		if (size + runHeaderBytes + changed >= stateSize)
+		{
+			return false;
+		}
+
+		uint8_t* pRun = scratch.data() + size;
+		memcpy(pRun, &unchanged, sizeof(uint16_t));
+		memcpy(pRun + sizeof(uint16_t), &changed, sizeof(uint16_t));
+		pRun += runHeaderBytes;
+		for (size_t i = 0; i < changed; i++)
+		{
+			pRun[i] = pState[start + i] ^ pKey[start + i];
+		}
+		size += uint32_t(runHeaderBytes + changed);
+		position = end;
+	}
+	return true;
+}
+
+//The bytes are used as a log that wraps, so the records in the way are always the oldest ones
+bool RewindBuffer::Append(const uint8_t* pData, uint32_t size, uint32_t recordKeyframeDistance)
+{
+	if (recordCount == frameCapacity)
+	{
+		EvictOldest();
+	}
+
+	const bool wrapped = writeOffset + size > byteCapacity;
+	const size_t offset = wrapped ? 0 : writeOffset;
+	while (recordCount > 0)
+	{
+		//Records past the write position are older than any at the start, so wrapping evicts them first
+		const Record& oldest = records[firstRecord];
+		const bool skipped = wrapped && oldest.offset >= writeOffset;
+		const bool overlaps = oldest.offset < offset + size && oldest.offset + oldest.size > offset;
+		if (!skipped && !overlaps)
+		{
+			break;
+		}
+		EvictOldest();
+	}
+
+	//A delta is no use without its keyframe
+	if (recordCount < recordKeyframeDistance)
+	{
+		return false;
+	}
+
+	memcpy(bytes.data() + offset, pData, size);
+	records[(firstRecord + recordCount) % frameCapacity] = { uint32_t(offset), size, recordKeyframeDistance };
+	recordCount++;
+	writeOffset = offset + size;
+	usedBytes += size;
+	return true;
+}
+
+//Deltas cannot be restored once their keyframe is gone, so they go with it
+void RewindBuffer::EvictOldest()
+{
+	do
+	{
+		usedBytes -= records[firstRecord].size;
+		firstRecord = (firstRecord + 1) % frameCapacity;
+		recordCount--;
+	} while (recordCount > 0 && records[firstRecord].keyframeDistance > 0);
+}
+
+const RewindBuffer::Record& RewindBuffer::GetRecord(size_t framesBack) const noexcept
+{
+	return records[(firstRecord + recordCount - 1 - framesBack) % frameCapacity];
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "MemoryTracker.h"
+#include <cstddef>
+#include <cstdint>
+
+//History of fixed size simulation states for rewinding, the newest frames kept in a fixed number of bytes
+//Every keyframeInterval-th state is kept whole, the ones between are XORed with their keyframe and only the runs that differ are kept
+//Capturing encodes against the keyframe in hand and restoring decodes one delta onto its keyframe, neither depends on how much history is kept
+//Record layout: a keyframe is the state, a delta is a list of (uint16 bytes unchanged, uint16 bytes changed, the changed bytes XORed)
+class RewindBuffer
+{
+public:
+	RewindBuffer(size_t _byteCapacity = 4 * 1024 * 1024, size_t _frameCapacity = 60 * 60 * 5, uint32_t _keyframeInterval = 60);
+	RewindBuffer(const RewindBuffer&) = delete;
+	RewindBuffer& operator=(const RewindBuffer&) = delete;
+
+	//Forgets the history, the states captured after this are stateSize bytes
+	//States too large to fit twice in the buffer are not kept
+	void Reset(size_t _stateSize);
+	void Capture(const uint8_t* pState);
+	//Writes the state framesBack frames before the newest, 0 being the newest
+	bool Restore(size_t framesBack, uint8_t* pState) const;
+	//Drops the newest frames, so capturing carries on from the one restored
+	void Truncate(size_t frames);
+
+	size_t GetFrameCount() const noexcept;
+	size_t GetUsedBytes() const noexcept;
+private:
+	struct Record
+	{
+		uint32_t offset;
+		uint32_t size;
+		//Frames since the keyframe the record was encoded against, 0 for the keyframe itself
+		uint32_t keyframeDistance;
+	};
+private:
+	//Fills scratch with the delta, returns false when it would be no smaller than a keyframe
+	bool EncodeDelta(const uint8_t* pState, uint32_t& size);
+	//Makes room for and copies a record, returns false if a delta's own keyframe had to be evicted for it
+	bool Append(const uint8_t* pData, uint32_t size, uint32_t keyframeDistance);
+	void EvictOldest();
+	const Record& GetRecord(size_t framesBack) const noexcept;
+private:
+	size_t byteCapacity;
+	size_t frameCapacity;
+	uint32_t keyframeInterval;
+	size_t stateSize = 0;
+
+	TrackedVector<uint8_t, MemoryTracker::RewindCategory> bytes;
+	//Ring of the records, oldest at firstRecord
+	TrackedVector<Record, MemoryTracker::RewindCategory> records;
+	size_t firstRecord = 0;
+	size_t recordCount = 0;
+	size_t writeOffset = 0;
+	size_t usedBytes = 0;
+
+	//The keyframe deltas are encoded against, and where the delta being encoded goes
+	TrackedVector<uint8_t, MemoryTracker::RewindCategory> keyframe;
+	TrackedVector<uint8_t, MemoryTracker::RewindCategory> scratch;
+	uint32_t keyframeDistance = 0;
+	bool hasKeyframe = false;
+};
@@ -0,0 +1,302 @@
+#include "Simulation.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "Systems.h"
+#include <cstddef>
+#include <cstring>
+
+//CollisionSystem works on plain floats, so the same maths runs in the benchmarks
+static Float3 ToFloat3(DirectX::FXMVECTOR vector) noexcept
+{
+	DirectX::XMFLOAT3 stored;
+	DirectX::XMStoreFloat3(&stored, vector);
+	return { stored.x, stored.y, stored.z };
+}
+
+//Adds the bytes of a value to a 64 bit FNV-1a hash, floats are hashed by their bits so any difference shows
+template<typename T>
+static void HashValue(uint64_t& hash, const T& value) noexcept
+{
+	uint8_t bytes[sizeof(T)];
+	memcpy(bytes, &value, sizeof(T));
+	for (const uint8_t byte : bytes)
+	{
+		hash ^= byte;
+		hash *= 1099511628211ull;
+	}
+}
+
+//The animator's fields without its trailing padding
+static constexpr size_t animatorBytes = offsetof(AnimatorComponent, group) + sizeof(AnimatorGroup);
+
+Simulation::Simulation()
+{
+	overlaps.reserve(256);
+}
+
+void Simulation::SetLevel(LevelState* _pLevel)
+{
+	pLevel = _pLevel;
+
+	const DirectX::XMFLOAT3& spawn = pLevel->spawnPosition;
+	player.SetSpawnPosition({ spawn.x, spawn.y, spawn.z });
+	player.SetPosition({ spawn.x, spawn.y, spawn.z });
+}
+
+LevelState* Simulation::GetLevel() const noexcept
+{
+	return pLevel;
+}
+
+bool Simulation::Step(const InputFrame& input, FrameStats& frameStats)
+{
+	//Player movement
+	{
+		PROFILE_SCOPE("Input and player");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::InputPhase);
+		UpdatePlayer(player, input);
+	}
+
+	//Stream level chunks around the player
+	{
+		PROFILE_SCOPE("Level streaming");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::StreamingPhase);
+		const Float3 playerCenter = player.GetCenter();
+		pLevel->Update(playerCenter.x, playerCenter.z);
+	}
+
+	//Animate the level's entities, then rebuild the world matrices and bounding boxes of the ones that moved
+	{
+		PROFILE_SCOPE("Animation and transforms");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::AnimationPhase);
+		AnimationSystem::Update(pLevel->registry, input.dt);
+		TransformSystem::Update(pLevel->registry);
+	}
+
+	//Triggers, reaching the goal is only reported after collision, as the last level has no next one to swap to and the player stays on it
+	bool goalReached = false;
+	{
+		PROFILE_SCOPE("Triggers");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::TriggerPhase);
+		FindPlayerOverlaps(OverlapCollider);
+		goalReached = TriggerSystem::Fire(pLevel->registry, overlaps);
+	}
+
+	{
+		PROFILE_SCOPE("Collision");
+		FrameStats::PhaseTimer phaseTimer(frameStats, FrameStats::CollisionPhase);
+		CollidePlayer();
+	}
+	return goalReached;
+}
+
+//Only the packed arrays of the few animated and trigger entities are walked, the static tiles never change
+uint64_t Simulation::GetStateHash() const noexcept
+{
+	uint64_t hash = 14695981039346656037ull;
+	HashValue(hash, pLevel->GetLevelNum());
+
+	const Float3& position = player.GetPosition();
+	const Float3& velocity = player.GetVelocity();
+	HashValue(hash, position.x);
+	HashValue(hash, position.y);
+	HashValue(hash, position.z);
+	HashValue(hash, velocity.x);
+	HashValue(hash, velocity.y);
+	HashValue(hash, velocity.z);
+	HashValue(hash, player.GetRotationY());
+	HashValue(hash, player.IsGrounded());
+
+	//Bridge, pressure plate and collectable heights, and where each is heading
+	const Registry& registry = pLevel->registry;
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		const TransformComponent& transform = registry.transforms.Get(registry.animators.GetEntityAt(i));
+		HashValue(hash, transform.position.y);
+		HashValue(hash, transform.rotation.y);
+		HashValue(hash, registry.animators.GetAt(i).yTarget);
+	}
+
+	//Fired triggers, and collectables hidden once picked up
+	for (size_t i = 0; i < registry.triggers.GetSize(); i++)
+	{
+		const RenderableComponent* pRenderable = registry.renderables.Find(registry.triggers.GetEntityAt(i));
+		HashValue(hash, registry.triggers.GetAt(i).fired);
+		HashValue(hash, pRenderable != nullptr && pRenderable->visible);
+	}
+	return hash;
+}
+
+//Player | Per animator: transform, animator | Per trigger: trigger, visible
+//Entities are never added or removed during a level, so the packed arrays keep their order between a save and a load
+size_t Simulation::GetStateSize() const noexcept
+{
+	const Registry& registry = pLevel->registry;
+	return sizeof(PlayerPhysics::State) +
+		registry.animators.GetSize() * (sizeof(TransformComponent) + sizeof(AnimatorComponent)) +
+		registry.triggers.GetSize() * (sizeof(TriggerComponent) + sizeof(bool));
+}
+
+void Simulation::SaveState(uint8_t* pState) const noexcept
+{
+	//Padding is zeroed, so unchanged states compare equal byte for byte
+	memset(pState, 0, GetStateSize());
+	const PlayerPhysics::State playerState = player.GetState();
+	memcpy(pState, &playerState.position, sizeof(Float3));
+	memcpy(pState + offsetof(PlayerPhysics::State, velocity), &playerState.velocity, sizeof(Float3));
+	memcpy(pState + offsetof(PlayerPhysics::State, yRot), &playerState.yRot, sizeof(float));
+	memcpy(pState + offsetof(PlayerPhysics::State, grounded), &playerState.grounded, sizeof(bool));
+	pState += sizeof(PlayerPhysics::State);
+
+	const Registry& registry = pLevel->registry;
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		memcpy(pState, &registry.transforms.Get(registry.animators.GetEntityAt(i)), sizeof(TransformComponent));
+		memcpy(pState + sizeof(TransformComponent), &registry.animators.GetAt(i), animatorBytes);
+		pState += sizeof(TransformComponent) + sizeof(AnimatorComponent);
+	}
+
+	for (size_t i = 0; i < registry.triggers.GetSize(); i++)
+	{
+		const RenderableComponent* pRenderable = registry.renderables.Find(registry.triggers.GetEntityAt(i));
+		const bool visible = pRenderable != nullptr && pRenderable->visible;
+		memcpy(pState, &registry.triggers.GetAt(i), sizeof(TriggerComponent));
+		memcpy(pState + sizeof(TriggerComponent), &visible, sizeof(bool));
+		pState += sizeof(TriggerComponent) + sizeof(bool);
+	}
+}
+
+void Simulation::LoadState(const uint8_t* pState)
+{
+	PlayerPhysics::State playerState;
+	memcpy(&playerState, pState, sizeof(PlayerPhysics::State));
+	player.SetState(playerState);
+	pState += sizeof(PlayerPhysics::State);
+
+	Registry& registry = pLevel->registry;
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		const Entity entity = registry.animators.GetEntityAt(i);
+		memcpy(&registry.transforms.Get(entity), pState, sizeof(TransformComponent));
+		memcpy(static_cast<void*>(&registry.animators.GetAt(i)), pState + sizeof(TransformComponent), animatorBytes);
+		registry.MarkDirty(entity);
+		pState += sizeof(TransformComponent) + sizeof(AnimatorComponent);
+	}
+
+	for (size_t i = 0; i < registry.triggers.GetSize(); i++)
+	{
+		memcpy(&registry.triggers.GetAt(i), pState, sizeof(TriggerComponent));
+		if (RenderableComponent* pRenderable = registry.renderables.Find(registry.triggers.GetEntityAt(i)))
+		{
+			memcpy(&pRenderable->visible, pState + sizeof(TriggerComponent), sizeof(bool));
+		}
+		pState += sizeof(TriggerComponent) + sizeof(bool);
+	}
+
+	TransformSystem::Update(registry);
+}
+
+void Simulation::UpdatePlayer(PlayerPhysics& player, const InputFrame& input) noexcept
+{
+	float verticle = 0;
+	float horizontal = 0;
+	float playerRotation = 0;
+
+	if (input.IsPressed(InputFrame::ForwardButton))
+	{
+		verticle = 1;
+	}
+	if (input.IsPressed(InputFrame::BackButton))
+	{
+		verticle = -1;
+	}
+	if (input.IsPressed(InputFrame::LeftButton))
+	{
+		horizontal = -1;
+	}
+	if (input.IsPressed(InputFrame::RightButton))
+	{
+		horizontal = 1;
+	}
+	if (input.IsPressed(InputFrame::TurnLeftButton))
+	{
+		playerRotation = -1;
+	}
+	if (input.IsPressed(InputFrame::TurnRightButton))
+	{
+		playerRotation = 1;
+	}
+	if (input.IsPressed(InputFrame::JumpButton))
+	{
+		player.Jump();
+	}
+
+	player.SetPlayerInput(horizontal, verticle);
+	player.SetRotationY(playerRotation * input.dt);
+	player.ApplyGravity(input.dt);
+	player.Update(input.dt);
+}
+
+void Simulation::FindPlayerOverlaps(ColliderType type)
+{
+	const BoundsComponent& bounds = player.GetBounds();
+	CollisionSystem::FindOverlaps(pLevel->registry, bounds.worldMin, bounds.worldMax, type, overlaps);
+}
+
+void Simulation::CollidePlayer()
+{
+	//Ground collision
+	player.SetGrounded(false);
+
+	for (LevelChunk* pChunk : pLevel->GetChunks())
+	{
+		for (const TileRecord& tile : pChunk->tiles)
+		{
+			const BoundsComponent& bounds = player.GetBounds();
+			const Float3 bMin = ToFloat3(tile.GetBBMinVertex());
+			const Float3 bMax = ToFloat3(tile.GetBBMaxVertex());
+
+			PerfCounters::Add(PerfCounters::CollisionTestCounter);
+			if (CollisionSystem::CheckOverlap(bounds.worldMin, bounds.worldMax, bMin, bMax))
+			{
+				CollisionResponse(player, bounds.worldMin, bounds.worldMax, bMin, bMax, player.GetCenter(), ToFloat3(tile.GetCenterVertex()));
+			}
+		}
+	}
+
+	//Bridges, each is checked again as earlier responses may already have pushed the player out of it
+	FindPlayerOverlaps(SolidCollider);
+	for (const Entity entity : overlaps)
+	{
+		const BoundsComponent& bridgeBounds = pLevel->registry.bounds.Get(entity);
+		const BoundsComponent& bounds = player.GetBounds();
+
+		PerfCounters::Add(PerfCounters::CollisionTestCounter);
+		if (CollisionSystem::CheckOverlap(bounds.worldMin, bounds.worldMax, bridgeBounds.worldMin, bridgeBounds.worldMax))
+		{
+			const Float3 bCenter = {
+				(bridgeBounds.worldMin.x + bridgeBounds.worldMax.x) * 0.5f,
+				(bridgeBounds.worldMin.y + bridgeBounds.worldMax.y) * 0.5f,
+				(bridgeBounds.worldMin.z + bridgeBounds.worldMax.z) * 0.5f };
+
+			CollisionResponse(player, bounds.worldMin, bounds.worldMax, bridgeBounds.worldMin, bridgeBounds.worldMax, player.GetCenter(), bCenter);
+		}
+	}
+}
+
+void Simulation::CollisionResponse(PlayerPhysics& player, const Float3& aMin, const Float3& aMax, const Float3& bMin, const Float3& bMax, const Float3& aCenter, const Float3& bCenter) noexcept
+{
+	const CollisionSystem::Response response = CollisionSystem::CalculateResponse(aMin, aMax, bMin, bMax, aCenter, bCenter);
+
+	if (response.grounded)
+	{
+		player.SetGrounded(true);
+	}
+
+	const Float3 velocity = player.GetVelocity();
+	player.MovePosition(response.push);
+	player.SetVelocity({
+		response.stopX ? 0.0f : velocity.x,
+		response.stopY ? 0.0f : velocity.y,
+		response.stopZ ? 0.0f : velocity.z });
+}
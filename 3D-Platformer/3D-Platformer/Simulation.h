@@ -0,0 +1,42 @@
+#pragma once
+#include "FrameStats.h"
+#include "InputRecording.h"
+#include "LevelState.h"
+#include "PlayerPhysics.h"
+#include <vector>
+
+//One frame of gameplay at a time, driven only by an InputFrame, so the keyboard and a recording step it the same way
+//Nothing here needs a window or a device, the replay tools run it headless on the same levels the game plays
+class Simulation
+{
+public:
+	Simulation();
+	//The player starts the level at its spawn point
+	void SetLevel(LevelState* _pLevel);
+	LevelState* GetLevel() const noexcept;
+	//Returns true when the player reached the goal, the owner then swaps in the next level
+	bool Step(const InputFrame& input, FrameStats& frameStats);
+	//Hash of everything a frame can change, the player, the animated entities' heights, the triggers and which collectables are left
+	//Two runs that hash the same on every frame took the same path, the first frame they differ on is where they diverged
+	uint64_t GetStateHash() const noexcept;
+
+	//The same state as a fixed number of bytes for the level, so snapshots of it can be kept and put back
+	size_t GetStateSize() const noexcept;
+	void SaveState(uint8_t* pState) const noexcept;
+	//Puts back a state saved on the same level, the entities it moves get their worlds and bounds rebuilt straight away
+	void LoadState(const uint8_t* pState);
+
+	//How a player moves for its input and is pushed out of a box, SimulationBatch moves its players with the same code
+	static void UpdatePlayer(PlayerPhysics& player, const InputFrame& input) noexcept;
+	static void CollisionResponse(PlayerPhysics& player, const Float3& aMin, const Float3& aMax, const Float3& bMin, const Float3& bMax, const Float3& aCenter, const Float3& bCenter) noexcept;
+private:
+	void FindPlayerOverlaps(ColliderType type);
+	void CollidePlayer();
+public:
+	PlayerPhysics player;
+private:
+	LevelState* pLevel = nullptr;
+
+	//Entities overlapping the player this frame, kept to reuse its memory
+	std::vector<Entity> overlaps;
+};
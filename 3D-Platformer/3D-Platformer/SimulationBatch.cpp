@@ -0,0 +1,478 @@
+#include "SimulationBatch.h"
+#include "JobSystem.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "Simulation.h"
+#include "Systems.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+//Same conversion as Simulation's, so the tile boxes are the same floats
+static Float3 ToFloat3(DirectX::FXMVECTOR vector) noexcept
+{
+	DirectX::XMFLOAT3 stored;
+	DirectX::XMStoreFloat3(&stored, vector);
+	return { stored.x, stored.y, stored.z };
+}
+
+//Every chunk of the level is built up front and never streamed, the instances can be anywhere on it
+SimulationBatch::SimulationBatch(int _levelNum, size_t _instanceCount) :
+	instanceCount(_instanceCount)
+{
+	ChunkStreamer::Settings settings;
+	settings.synchronous = true;
+	settings.loadRadius = 1.0e9f;
+	settings.unloadRadius = 1.0e9f;
+	settings.memoryBudget = SIZE_MAX;
+	chunkSize = settings.chunkSize;
+
+	std::unique_ptr<LevelState> pBuilt = LevelState::BuildHeadless(_levelNum, settings);
+	const Registry& registry = pBuilt->registry;
+	spawn = { pBuilt->spawnPosition.x, pBuilt->spawnPosition.y, pBuilt->spawnPosition.z };
+
+	//Entities are looked up by their index in the packed arrays from here on
+	std::unordered_map<Entity, uint32_t> animatorIndices;
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		const Entity entity = registry.animators.GetEntityAt(i);
+		const BoundsComponent* pBounds = registry.bounds.Find(entity);
+		animators.push_back({ registry.transforms.Get(entity), registry.animators.GetAt(i), pBounds ? *pBounds : BoundsComponent() });
+		animatorIndices[entity] = uint32_t(i);
+	}
+
+	std::unordered_map<Entity, uint32_t> triggerIndices;
+	for (size_t i = 0; i < registry.triggers.GetSize(); i++)
+	{
+		const Entity entity = registry.triggers.GetEntityAt(i);
+		const TriggerComponent& trigger = registry.triggers.GetAt(i);
+		const auto animator = animatorIndices.find(entity);
+		triggers.push_back({ trigger.action, trigger.targetGroup, animator != animatorIndices.end() ? animator->second : noIndex });
+		triggerIndices[entity] = uint32_t(i);
+	}
+
+	for (size_t i = 0; i < registry.colliders.GetSize(); i++)
+	{
+		const Entity entity = registry.colliders.GetEntityAt(i);
+		const BoundsComponent* pBounds = registry.bounds.Find(entity);
+		const auto animator = animatorIndices.find(entity);
+		const auto trigger = triggerIndices.find(entity);
+
+		//Like CollisionSystem::FindOverlaps, a collider without bounds never overlaps
+		if (pBounds == nullptr)
+		{
+			continue;
+		}
+		colliders.push_back({ registry.colliders.GetAt(i).type,
+			animator != animatorIndices.end() ? animator->second : noIndex,
+			trigger != triggerIndices.end() ? trigger->second : noIndex,
+			pBounds->worldMin, pBounds->worldMax });
+	}
+
+	for (const LevelChunk* pChunk : pBuilt->GetChunks())
+	{
+		chunkCountX = (std::max)(chunkCountX, int32_t(pChunk->GetChunkX()) + 1);
+		chunkCountZ = (std::max)(chunkCountZ, int32_t(pChunk->GetChunkZ()) + 1);
+	}
+	chunkGrid.resize(size_t(chunkCountX) * size_t(chunkCountZ));
+	for (const LevelChunk* pChunk : pBuilt->GetChunks())
+	{
+		ChunkInfo& chunk = chunkGrid[size_t(pChunk->GetChunkX()) * chunkCountZ + pChunk->GetChunkZ()];
+		chunk.pChunk = pChunk;
+		chunk.boundsMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+		chunk.boundsMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+		for (const TileRecord& tile : pChunk->tiles)
+		{
+			const Float3 tileMin = ToFloat3(tile.GetBBMinVertex());
+			const Float3 tileMax = ToFloat3(tile.GetBBMaxVertex());
+			chunk.boundsMin = { (std::min)(chunk.boundsMin.x, tileMin.x), (std::min)(chunk.boundsMin.y, tileMin.y), (std::min)(chunk.boundsMin.z, tileMin.z) };
+			chunk.boundsMax = { (std::max)(chunk.boundsMax.x, tileMax.x), (std::max)(chunk.boundsMax.y, tileMax.y), (std::max)(chunk.boundsMax.z, tileMax.z) };
+		}
+	}
+	pLevel = std::move(pBuilt);
+
+	for (TrackedVector<float, MemoryTracker::BatchCategory>* pStream : {
+		&positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ, &rotationY })
+	{
+		pStream->resize(instanceCount);
+	}
+	grounded.resize(instanceCount);
+	collected.resize(instanceCount);
+	done.resize(instanceCount);
+
+	for (TrackedVector<float, MemoryTracker::BatchCategory>* pStream : {
+		&animatorY, &animatorRotationY, &animatorTarget, &animatorSpeed,
+		&boundsMinX, &boundsMinY, &boundsMinZ, &boundsMaxX, &boundsMaxY, &boundsMaxZ })
+	{
+		pStream->resize(instanceCount * animators.size());
+	}
+	fired.resize(instanceCount * triggers.size());
+
+	//Scratch sized for the worst frame up front
+	slices.resize((instanceCount + sliceSize - 1) / sliceSize);
+	for (Slice& slice : slices)
+	{
+		slice.player.SetSpawnPosition(spawn);
+		slice.transforms.Resize(animators.size());
+		slice.moved.reserve(animators.size());
+		slice.overlaps.reserve(colliders.size());
+	}
+
+	Reset();
+}
+
+void SimulationBatch::Reset() noexcept
+{
+	for (size_t instance = 0; instance < instanceCount; instance++)
+	{
+		Reset(instance);
+	}
+}
+
+//The same start Simulation::SetLevel gives a new player
+void SimulationBatch::Reset(size_t instance) noexcept
+{
+	positionX[instance] = spawn.x;
+	positionY[instance] = spawn.y;
+	positionZ[instance] = spawn.z;
+	velocityX[instance] = 0.0f;
+	velocityY[instance] = 0.0f;
+	velocityZ[instance] = 0.0f;
+	rotationY[instance] = 0.0f;
+	grounded[instance] = 0;
+	collected[instance] = 0;
+	done[instance] = 0;
+
+	const size_t base = instance * animators.size();
+	for (size_t i = 0; i < animators.size(); i++)
+	{
+		const AnimatorInfo& animator = animators[i];
+		animatorY[base + i] = animator.transform.position.y;
+		animatorRotationY[base + i] = animator.transform.rotation.y;
+		animatorTarget[base + i] = animator.animator.yTarget;
+		animatorSpeed[base + i] = animator.animator.speed;
+		boundsMinX[base + i] = animator.bounds.worldMin.x;
+		boundsMinY[base + i] = animator.bounds.worldMin.y;
+		boundsMinZ[base + i] = animator.bounds.worldMin.z;
+		boundsMaxX[base + i] = animator.bounds.worldMax.x;
+		boundsMaxY[base + i] = animator.bounds.worldMax.y;
+		boundsMaxZ[base + i] = animator.bounds.worldMax.z;
+	}
+	std::fill_n(fired.begin() + instance * triggers.size(), triggers.size(), uint8_t(0));
+}
+
+//One job per slice, the counters are summed per slice and added once so the jobs do not contend on them
+void SimulationBatch::Step(const InputFrame* pInputs)
+{
+	PROFILE_SCOPE("Batch step");
+
+	JobSystem::ParallelFor(slices.size(), 1, [this, pInputs](size_t begin, size_t end)
+	{
+		for (size_t sliceIndex = begin; sliceIndex < end; sliceIndex++)
+		{
+			Slice& slice = slices[sliceIndex];
+			const size_t last = (std::min)((sliceIndex + 1) * sliceSize, instanceCount);
+			for (size_t instance = sliceIndex * sliceSize; instance < last; instance++)
+			{
+				if (!done[instance])
+				{
+					StepInstance(slice, instance, pInputs[instance]);
+				}
+			}
+		}
+	});
+
+	for (Slice& slice : slices)
+	{
+		PerfCounters::Add(PerfCounters::ObjectsUpdatedCounter, slice.objectsUpdated);
+		PerfCounters::Add(PerfCounters::CollisionTestCounter, slice.collisionTests);
+		slice.objectsUpdated = 0;
+		slice.collisionTests = 0;
+	}
+}
+
+size_t SimulationBatch::GetInstanceCount() const noexcept
+{
+	return instanceCount;
+}
+
+const LevelState& SimulationBatch::GetLevel() const noexcept
+{
+	return *pLevel;
+}
+
+size_t SimulationBatch::GetInstanceBytes() const noexcept
+{
+	return 7 * sizeof(float) + sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint8_t) +
+		animators.size() * 10 * sizeof(float) +
+		triggers.size() * sizeof(uint8_t);
+}
+
+//Simulation::Step for one instance, without the streaming as every chunk is already built
+void SimulationBatch::StepInstance(Slice& slice, size_t instance, const InputFrame& input) noexcept
+{
+	PlayerPhysics& player = slice.player;
+	player.SetState({
+		{ positionX[instance], positionY[instance], positionZ[instance] },
+		{ velocityX[instance], velocityY[instance], velocityZ[instance] },
+		rotationY[instance], grounded[instance] != 0 });
+
+	Simulation::UpdatePlayer(player, input);
+	Animate(slice, instance, input.dt);
+
+	//The player still collides on the step it reaches the goal, as in Simulation
+	const bool goalReached = FireTriggers(slice, instance);
+	CollidePlayer(slice, instance);
+	if (goalReached)
+	{
+		done[instance] = 1;
+	}
+
+	const PlayerPhysics::State state = player.GetState();
+	positionX[instance] = state.position.x;
+	positionY[instance] = state.position.y;
+	positionZ[instance] = state.position.z;
+	velocityX[instance] = state.velocity.x;
+	velocityY[instance] = state.velocity.y;
+	velocityZ[instance] = state.velocity.z;
+	rotationY[instance] = state.yRot;
+	grounded[instance] = state.grounded ? 1 : 0;
+}
+
+//AnimationSystem::Update and then TransformSystem::Update for the entities that moved, with the same TransformBatch maths
+void SimulationBatch::Animate(Slice& slice, size_t instance, float dt) noexcept
+{
+	const size_t base = instance * animators.size();
+	slice.moved.clear();
+	for (size_t i = 0; i < animators.size(); i++)
+	{
+		const AnimatorComponent& animator = animators[i].animator;
+		float& y = animatorY[base + i];
+		const float yTarget = animatorTarget[base + i];
+		if (y == yTarget && animator.spinSpeed == 0.0f)
+		{
+			continue;
+		}
+
+		const float speed = animatorSpeed[base + i];
+		if (y < yTarget)
+		{
+			y += speed * dt;
+
+			if (y >= yTarget)
+			{
+				y = yTarget;
+			}
+		}
+		else if (y > yTarget)
+		{
+			y -= speed * dt;
+
+			if (y <= yTarget)
+			{
+				y = yTarget;
+			}
+		}
+
+		animatorRotationY[base + i] += animator.spinSpeed * dt;
+		slice.moved.push_back(uint32_t(i));
+	}
+
+	if (slice.moved.empty())
+	{
+		return;
+	}
+	slice.objectsUpdated += slice.moved.size() * 2;
+
+	TransformBatch& batch = slice.transforms;
+	batch.Resize(slice.moved.size());
+	for (size_t j = 0; j < slice.moved.size(); j++)
+	{
+		const size_t i = slice.moved[j];
+		const TransformComponent& transform = animators[i].transform;
+		const BoundsComponent& bounds = animators[i].bounds;
+		batch.positionX[j] = transform.position.x;
+		batch.positionY[j] = animatorY[base + i];
+		batch.positionZ[j] = transform.position.z;
+		batch.rotationX[j] = transform.rotation.x;
+		batch.rotationY[j] = animatorRotationY[base + i];
+		batch.rotationZ[j] = transform.rotation.z;
+		batch.scaleX[j] = transform.scale.x;
+		batch.scaleY[j] = transform.scale.y;
+		batch.scaleZ[j] = transform.scale.z;
+		batch.modelCenterX[j] = (bounds.modelMin.x + bounds.modelMax.x) * 0.5f;
+		batch.modelCenterY[j] = (bounds.modelMin.y + bounds.modelMax.y) * 0.5f;
+		batch.modelCenterZ[j] = (bounds.modelMin.z + bounds.modelMax.z) * 0.5f;
+		batch.modelExtentX[j] = (bounds.modelMax.x - bounds.modelMin.x) * 0.5f;
+		batch.modelExtentY[j] = (bounds.modelMax.y - bounds.modelMin.y) * 0.5f;
+		batch.modelExtentZ[j] = (bounds.modelMax.z - bounds.modelMin.z) * 0.5f;
+	}
+
+	//Already on a job, so the batch runs here rather than splitting itself into more
+	batch.Run(0, (slice.moved.size() + 3) & ~size_t(3));
+
+	for (size_t j = 0; j < slice.moved.size(); j++)
+	{
+		const size_t i = base + slice.moved[j];
+		boundsMinX[i] = batch.centerX[j] - batch.extentX[j];
+		boundsMinY[i] = batch.centerY[j] - batch.extentY[j];
+		boundsMinZ[i] = batch.centerZ[j] - batch.extentZ[j];
+		boundsMaxX[i] = batch.centerX[j] + batch.extentX[j];
+		boundsMaxY[i] = batch.centerY[j] + batch.extentY[j];
+		boundsMaxZ[i] = batch.centerZ[j] + batch.extentZ[j];
+	}
+}
+
+//TriggerSystem::Fire on the instance's own triggers
+bool SimulationBatch::FireTriggers(Slice& slice, size_t instance) noexcept
+{
+	FindOverlaps(slice, instance, OverlapCollider);
+
+	bool goalReached = false;
+	for (const uint32_t collider : slice.overlaps)
+	{
+		const uint32_t trigger = colliders[collider].trigger;
+		if (trigger == noIndex || fired[instance * triggers.size() + trigger])
+		{
+			continue;
+		}
+
+		switch (triggers[trigger].action)
+		{
+		case CollectTrigger:
+			collected[instance]++;
+			fired[instance * triggers.size() + trigger] = 1;
+			break;
+
+		case ActivateGroupTrigger:
+			if (triggers[trigger].animator != noIndex)
+			{
+				Activate(instance, triggers[trigger].animator);
+			}
+			if (triggers[trigger].targetGroup != NoAnimatorGroup)
+			{
+				for (size_t i = 0; i < animators.size(); i++)
+				{
+					if (animators[i].animator.group == triggers[trigger].targetGroup)
+					{
+						Activate(instance, uint32_t(i));
+					}
+				}
+			}
+			fired[instance * triggers.size() + trigger] = 1;
+			break;
+
+		case GoalTrigger:
+			goalReached = true;
+			break;
+		}
+	}
+	return goalReached;
+}
+
+void SimulationBatch::Activate(size_t instance, uint32_t animator) noexcept
+{
+	const size_t index = instance * animators.size() + animator;
+	animatorTarget[index] = animators[animator].animator.activeY;
+	animatorSpeed[index] = animators[animator].animator.activeSpeed;
+}
+
+//Simulation::CollidePlayer, only the chunks near the player are walked but their tiles are tested in the same order
+void SimulationBatch::CollidePlayer(Slice& slice, size_t instance) noexcept
+{
+	PlayerPhysics& player = slice.player;
+	player.SetGrounded(false);
+
+	//The tiles the player overlaps, with a chunk to spare on every side for how far the responses can push it
+	const BoundsComponent& startBounds = player.GetBounds();
+	const float size = float(chunkSize);
+	const int32_t minX = (std::max)(int32_t(std::floor((startBounds.worldMin.x - 0.5f) / size)) - 1, 0);
+	const int32_t maxX = (std::min)(int32_t(std::floor((startBounds.worldMax.x + 0.5f) / size)) + 1, chunkCountX - 1);
+	const int32_t minZ = (std::max)(int32_t(std::floor((startBounds.worldMin.z - 0.5f) / size)) - 1, 0);
+	const int32_t maxZ = (std::min)(int32_t(std::floor((startBounds.worldMax.z + 0.5f) / size)) + 1, chunkCountZ - 1);
+
+	for (int32_t chunkX = minX; chunkX <= maxX; chunkX++)
+	{
+		for (int32_t chunkZ = minZ; chunkZ <= maxZ; chunkZ++)
+		{
+			const ChunkInfo& chunk = chunkGrid[size_t(chunkX) * chunkCountZ + chunkZ];
+			if (chunk.pChunk == nullptr ||
+				!CollisionSystem::CheckOverlap(player.GetBounds().worldMin, player.GetBounds().worldMax, chunk.boundsMin, chunk.boundsMax))
+			{
+				continue;
+			}
+
+			for (const TileRecord& tile : chunk.pChunk->tiles)
+			{
+				const BoundsComponent& bounds = player.GetBounds();
+				const Float3 bMin = ToFloat3(tile.GetBBMinVertex());
+				const Float3 bMax = ToFloat3(tile.GetBBMaxVertex());
+
+				slice.collisionTests++;
+				if (CollisionSystem::CheckOverlap(bounds.worldMin, bounds.worldMax, bMin, bMax))
+				{
+					Simulation::CollisionResponse(player, bounds.worldMin, bounds.worldMax, bMin, bMax, player.GetCenter(), ToFloat3(tile.GetCenterVertex()));
+				}
+			}
+		}
+	}
+
+	//Bridges, each is checked again as earlier responses may already have pushed the player out of it
+	FindOverlaps(slice, instance, SolidCollider);
+	for (const uint32_t collider : slice.overlaps)
+	{
+		Float3 bridgeMin, bridgeMax;
+		GetColliderBounds(instance, collider, bridgeMin, bridgeMax);
+		const BoundsComponent& bounds = player.GetBounds();
+
+		slice.collisionTests++;
+		if (CollisionSystem::CheckOverlap(bounds.worldMin, bounds.worldMax, bridgeMin, bridgeMax))
+		{
+			const Float3 bCenter = {
+				(bridgeMin.x + bridgeMax.x) * 0.5f,
+				(bridgeMin.y + bridgeMax.y) * 0.5f,
+				(bridgeMin.z + bridgeMax.z) * 0.5f };
+
+			Simulation::CollisionResponse(player, bounds.worldMin, bounds.worldMax, bridgeMin, bridgeMax, player.GetCenter(), bCenter);
+		}
+	}
+}
+
+//CollisionSystem::FindOverlaps against the instance's boxes, the overlapping colliders' indices are left in the slice
+void SimulationBatch::FindOverlaps(Slice& slice, size_t instance, ColliderType type) noexcept
+{
+	const BoundsComponent& bounds = slice.player.GetBounds();
+	slice.overlaps.clear();
+	for (size_t i = 0; i < colliders.size(); i++)
+	{
+		if (colliders[i].type != type)
+		{
+			continue;
+		}
+		slice.collisionTests++;
+
+		Float3 worldMin, worldMax;
+		GetColliderBounds(instance, uint32_t(i), worldMin, worldMax);
+		if (CollisionSystem::CheckOverlap(bounds.worldMin, bounds.worldMax, worldMin, worldMax))
+		{
+			slice.overlaps.push_back(uint32_t(i));
+		}
+	}
+}
+
+void SimulationBatch::GetColliderBounds(size_t instance, uint32_t collider, Float3& worldMin, Float3& worldMax) const noexcept
+{
+	const uint32_t animator = colliders[collider].animator;
+	if (animator == noIndex)
+	{
+		worldMin = colliders[collider].worldMin;
+		worldMax = colliders[collider].worldMax;
+		return;
+	}
+
+	const size_t i = instance * animators.size() + animator;
+	worldMin = { boundsMinX[i], boundsMinY[i], boundsMinZ[i] };
+	worldMax = { boundsMaxX[i], boundsMaxY[i], boundsMaxZ[i] };
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "InputRecording.h"
+#include "LevelState.h"
+#include "MemoryTracker.h"
+#include "PlayerPhysics.h"
+#include "TransformBatch.h"
+#include <memory>
+#include <vector>
+
+//Many independent runs of one level stepped in lockstep, for automated playtesting
+//The level's tiles and entity layout are built once and only read, an instance is its player, its animated entities' heights and the triggers it fired
+//Instance state is kept as one array per field (structure of arrays), entity fields are indexed by instance * entity count + entity
+//An instance moves exactly as a Simulation given the same inputs would, through the same player, animation, trigger and collision maths
+class SimulationBatch
+{
+public:
+	//Instances stepped by one job, each slice has its own scratch space so stepping does not allocate
+	static constexpr size_t sliceSize = 64;
+public:
+	SimulationBatch(int _levelNum, size_t _instanceCount);
+	SimulationBatch(const SimulationBatch&) = delete;
+	SimulationBatch& operator=(const SimulationBatch&) = delete;
+
+	//Puts every instance, or one, back at the spawn point of the untouched level
+	void Reset() noexcept;
+	void Reset(size_t instance) noexcept;
+	//Steps every instance that is not done by its own input, pInputs holds one frame per instance
+	void Step(const InputFrame* pInputs);
+
+	size_t GetInstanceCount() const noexcept;
+	const LevelState& GetLevel() const noexcept;
+	//Bytes held for each instance, the level is shared by all of them
+	size_t GetInstanceBytes() const noexcept;
+private:
+	static constexpr uint32_t noIndex = UINT32_MAX;
+
+	//What every instance of an animated entity starts from and shares
+	struct AnimatorInfo
+	{
+		TransformComponent transform;
+		AnimatorComponent animator;
+		BoundsComponent bounds;
+	};
+
+	//Colliders in the registry's order, so overlaps are found and responded to in the order Simulation finds them
+	struct ColliderInfo
+	{
+		ColliderType type;
+		uint32_t animator;
+		uint32_t trigger;
+		//World box of an entity that never moves
+		Float3 worldMin;
+		Float3 worldMax;
+	};
+
+	struct TriggerInfo
+	{
+		TriggerAction action;
+		AnimatorGroup targetGroup;
+		uint32_t animator;
+	};
+
+	//A chunk and the box around its tiles, so a player nowhere near it skips its tiles
+	struct ChunkInfo
+	{
+		const LevelChunk* pChunk = nullptr;
+		Float3 boundsMin;
+		Float3 boundsMax;
+	};
+
+	struct Slice
+	{
+		PlayerPhysics player;
+		TransformBatch transforms;
+		std::vector<uint32_t> moved;
+		std::vector<uint32_t> overlaps;
+		uint64_t objectsUpdated = 0;
+		uint64_t collisionTests = 0;
+	};
+private:
+	void StepInstance(Slice& slice, size_t instance, const InputFrame& input) noexcept;
+	void Animate(Slice& slice, size_t instance, float dt) noexcept;
+	//Returns true when the player reached the goal
+	bool FireTriggers(Slice& slice, size_t instance) noexcept;
+	void Activate(size_t instance, uint32_t animator) noexcept;
+	void CollidePlayer(Slice& slice, size_t instance) noexcept;
+	void FindOverlaps(Slice& slice, size_t instance, ColliderType type) noexcept;
+	void GetColliderBounds(size_t instance, uint32_t collider, Float3& worldMin, Float3& worldMax) const noexcept;
+public:
+	//The players after the last step, indexed by instance, written by Step and Reset
+	TrackedVector<float, MemoryTracker::BatchCategory> positionX, positionY, positionZ;
+	TrackedVector<float, MemoryTracker::BatchCategory> velocityX, velocityY, velocityZ;
+	TrackedVector<float, MemoryTracker::BatchCategory> rotationY;
+	TrackedVector<uint8_t, MemoryTracker::BatchCategory> grounded;
+	TrackedVector<uint32_t, MemoryTracker::BatchCategory> collected;
+	//Set once the goal is reached, a done instance is not stepped again until it is reset
+	TrackedVector<uint8_t, MemoryTracker::BatchCategory> done;
+private:
+	size_t instanceCount;
+
+	//Shared by every instance
+	std::unique_ptr<const LevelState> pLevel;
+	Float3 spawn;
+	std::vector<AnimatorInfo> animators;
+	std::vector<ColliderInfo> colliders;
+	std::vector<TriggerInfo> triggers;
+	uint32_t chunkSize;
+	int32_t chunkCountX = 0;
+	int32_t chunkCountZ = 0;
+	//Indexed by chunkX * chunkCountZ + chunkZ, the order of the chunk keys Simulation collides in
+	std::vector<ChunkInfo> chunkGrid;
+
+	//Per instance animated entities, their height, spin, where they are heading and their world box
+	TrackedVector<float, MemoryTracker::BatchCategory> animatorY, animatorRotationY, animatorTarget, animatorSpeed;
+	TrackedVector<float, MemoryTracker::BatchCategory> boundsMinX, boundsMinY, boundsMinZ, boundsMaxX, boundsMaxY, boundsMaxZ;
+	//Per instance triggers
+	TrackedVector<uint8_t, MemoryTracker::BatchCategory> fired;
+
+	std::vector<Slice> slices;
+};
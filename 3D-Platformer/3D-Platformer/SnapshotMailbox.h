@@ -0,0 +1,87 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+//Hands the newest of a stream of snapshots from one producer thread to one consumer thread through three buffers
+//The producer always has a buffer to write into and never waits, snapshots the consumer was too slow for are overwritten
+//Buffers are reused, so their memory is only allocated while it grows
+template<typename T>
+class SnapshotMailbox
+{
+public:
+	SnapshotMailbox() = default;
+	SnapshotMailbox(const SnapshotMailbox&) = delete;
+	SnapshotMailbox& operator=(const SnapshotMailbox&) = delete;
+
+	//Producer: fill the write buffer, then publish it
+	T& GetWriteBuffer() noexcept
+	{
+		return buffers[writeIndex];
+	}
+
+	void Publish()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			std::swap(writeIndex, readyIndex);
+			hasNew = true;
+		}
+		condition.notify_all();
+	}
+
+	//Producer: waits until the consumer has finished with every published snapshot
+	//Needed before destroying anything a snapshot points to
+	void WaitUntilIdle()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this]() { return closed || (!hasNew && !reading); });
+	}
+
+	//Consumer: waits for a snapshot newer than the last one, returns nullptr once the mailbox is closed
+	//The snapshot stays valid until Release
+	const T* Acquire()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this]() { return closed || hasNew; });
+		if (closed)
+		{
+			return nullptr;
+		}
+		std::swap(readIndex, readyIndex);
+		hasNew = false;
+		reading = true;
+		return &buffers[readIndex];
+	}
+
+	void Release()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			reading = false;
+		}
+		condition.notify_all();
+	}
+
+	//Wakes both threads for shutdown
+	void Close()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closed = true;
+		}
+		condition.notify_all();
+	}
+private:
+	T buffers[3];
+	size_t writeIndex = 0;
+	size_t readyIndex = 1;
+	size_t readIndex = 2;
+
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool hasNew = false;
+	bool reading = false;
+	bool closed = false;
+};
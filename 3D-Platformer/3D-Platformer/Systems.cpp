@@ -0,0 +1,290 @@
+#include "Systems.h"
+#include "PerfCounters.h"
+#include <algorithm>
+#include <cmath>
+
+void AnimationSystem::Update(Registry& registry, float dt) noexcept
+{
+	uint64_t updated = 0;
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		AnimatorComponent& animator = registry.animators.GetAt(i);
+		const Entity entity = registry.animators.GetEntityAt(i);
+		TransformComponent* pTransform = registry.transforms.Find(entity);
+		if (pTransform == nullptr || (pTransform->position.y == animator.yTarget && animator.spinSpeed == 0.0f))
+		{
+			continue;
+		}
+
+		float& y = pTransform->position.y;
+		if (y < animator.yTarget)
+		{
+			y += animator.speed * dt;
+
+			if (y >= animator.yTarget)
+			{
+				y = animator.yTarget;
+			}
+		}
+		else if (y > animator.yTarget)
+		{
+			y -= animator.speed * dt;
+
+			if (y <= animator.yTarget)
+			{
+				y = animator.yTarget;
+			}
+		}
+
+		pTransform->rotation.y += animator.spinSpeed * dt;
+		registry.MarkDirty(entity);
+		updated++;
+	}
+	PerfCounters::Add(PerfCounters::ObjectsUpdatedCounter, updated);
+}
+
+void AnimationSystem::Activate(Registry& registry, Entity entity) noexcept
+{
+	if (AnimatorComponent* pAnimator = registry.animators.Find(entity))
+	{
+		pAnimator->yTarget = pAnimator->activeY;
+		pAnimator->speed = pAnimator->activeSpeed;
+	}
+}
+
+void AnimationSystem::ActivateGroup(Registry& registry, AnimatorGroup group) noexcept
+{
+	if (group == NoAnimatorGroup)
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < registry.animators.GetSize(); i++)
+	{
+		AnimatorComponent& animator = registry.animators.GetAt(i);
+		if (animator.group == group)
+		{
+			animator.yTarget = animator.activeY;
+			animator.speed = animator.activeSpeed;
+		}
+	}
+}
+
+void TransformSystem::Update(Registry& registry)
+{
+	std::vector<Entity>& entities = registry.batchEntities;
+	entities.clear();
+	for (const Entity entity : registry.GetDirtyEntities())
+	{
+		if (registry.transforms.Has(entity) && registry.worlds.Has(entity))
+		{
+			entities.push_back(entity);
+		}
+	}
+
+	if (entities.empty())
+	{
+		registry.ClearDirty();
+		return;
+	}
+
+	TransformBatch& batch = registry.transformBatch;
+	batch.Resize(entities.size());
+
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		const TransformComponent& transform = registry.transforms.Get(entities[i]);
+		batch.positionX[i] = transform.position.x;
+		batch.positionY[i] = transform.position.y;
+		batch.positionZ[i] = transform.position.z;
+		batch.rotationX[i] = transform.rotation.x;
+		batch.rotationY[i] = transform.rotation.y;
+		batch.rotationZ[i] = transform.rotation.z;
+		batch.scaleX[i] = transform.scale.x;
+		batch.scaleY[i] = transform.scale.y;
+		batch.scaleZ[i] = transform.scale.z;
+
+		//Entities without bounds get an empty box that is never written back
+		const BoundsComponent* pBounds = registry.bounds.Find(entities[i]);
+		batch.modelCenterX[i] = pBounds ? (pBounds->modelMin.x + pBounds->modelMax.x) * 0.5f : 0.0f;
+		batch.modelCenterY[i] = pBounds ? (pBounds->modelMin.y + pBounds->modelMax.y) * 0.5f : 0.0f;
+		batch.modelCenterZ[i] = pBounds ? (pBounds->modelMin.z + pBounds->modelMax.z) * 0.5f : 0.0f;
+		batch.modelExtentX[i] = pBounds ? (pBounds->modelMax.x - pBounds->modelMin.x) * 0.5f : 0.0f;
+		batch.modelExtentY[i] = pBounds ? (pBounds->modelMax.y - pBounds->modelMin.y) * 0.5f : 0.0f;
+		batch.modelExtentZ[i] = pBounds ? (pBounds->modelMax.z - pBounds->modelMin.z) * 0.5f : 0.0f;
+	}
+
+	batch.Run();
+	PerfCounters::Add(PerfCounters::ObjectsUpdatedCounter, entities.size());
+
+	for (size_t i = 0; i < entities.size(); i++)
+	{
+		WorldComponent& world = registry.worlds.Get(entities[i]);
+		world.axisX = { batch.axisXX[i], batch.axisXY[i], batch.axisXZ[i] };
+		world.axisY = { batch.axisYX[i], batch.axisYY[i], batch.axisYZ[i] };
+		world.axisZ = { batch.axisZX[i], batch.axisZY[i], batch.axisZZ[i] };
+		world.translation = { batch.positionX[i], batch.positionY[i], batch.positionZ[i] };
+
+		if (BoundsComponent* pBounds = registry.bounds.Find(entities[i]))
+		{
+			pBounds->worldMin = { batch.centerX[i] - batch.extentX[i], batch.centerY[i] - batch.extentY[i], batch.centerZ[i] - batch.extentZ[i] };
+			pBounds->worldMax = { batch.centerX[i] + batch.extentX[i], batch.centerY[i] + batch.extentY[i], batch.centerZ[i] + batch.extentZ[i] };
+		}
+	}
+
+	registry.ClearDirty();
+}
+
+//Scale, then roll pitch yaw rotation, then translation, the same matrix as GameObject::GetTransformXM
+void TransformSystem::CalculateWorld(const TransformComponent& transform, WorldComponent& world) noexcept
+{
+	const float cp = std::cos(transform.rotation.x);
+	const float sp = std::sin(transform.rotation.x);
+	const float cy = std::cos(transform.rotation.y);
+	const float sy = std::sin(transform.rotation.y);
+	const float cr = std::cos(transform.rotation.z);
+	const float sr = std::sin(transform.rotation.z);
+
+	world.axisX = { (cr * cy + sr * sp * sy) * transform.scale.x, sr * cp * transform.scale.x, (sr * sp * cy - cr * sy) * transform.scale.x };
+	world.axisY = { (cr * sp * sy - sr * cy) * transform.scale.y, cr * cp * transform.scale.y, (sr * sy + cr * sp * cy) * transform.scale.y };
+	world.axisZ = { cp * sy * transform.scale.z, -sp * transform.scale.z, cp * cy * transform.scale.z };
+	world.translation = transform.position;
+}
+
+//Same box GameObject::CalculateAABB gets from transforming the 8 corners, found from the centre and half extents instead
+void TransformSystem::CalculateWorldBounds(const WorldComponent& world, BoundsComponent& bounds) noexcept
+{
+	const float centerX = (bounds.modelMin.x + bounds.modelMax.x) * 0.5f;
+	const float centerY = (bounds.modelMin.y + bounds.modelMax.y) * 0.5f;
+	const float centerZ = (bounds.modelMin.z + bounds.modelMax.z) * 0.5f;
+	const float extentX = (bounds.modelMax.x - bounds.modelMin.x) * 0.5f;
+	const float extentY = (bounds.modelMax.y - bounds.modelMin.y) * 0.5f;
+	const float extentZ = (bounds.modelMax.z - bounds.modelMin.z) * 0.5f;
+
+	const float worldX = centerX * world.axisX.x + centerY * world.axisY.x + centerZ * world.axisZ.x + world.translation.x;
+	const float worldY = centerX * world.axisX.y + centerY * world.axisY.y + centerZ * world.axisZ.y + world.translation.y;
+	const float worldZ = centerX * world.axisX.z + centerY * world.axisY.z + centerZ * world.axisZ.z + world.translation.z;
+
+	const float halfX = extentX * std::fabs(world.axisX.x) + extentY * std::fabs(world.axisY.x) + extentZ * std::fabs(world.axisZ.x);
+	const float halfY = extentX * std::fabs(world.axisX.y) + extentY * std::fabs(world.axisY.y) + extentZ * std::fabs(world.axisZ.y);
+	const float halfZ = extentX * std::fabs(world.axisX.z) + extentY * std::fabs(world.axisY.z) + extentZ * std::fabs(world.axisZ.z);
+
+	bounds.worldMin = { worldX - halfX, worldY - halfY, worldZ - halfZ };
+	bounds.worldMax = { worldX + halfX, worldY + halfY, worldZ + halfZ };
+}
+
+bool CollisionSystem::CheckOverlap(const Float3& aMin, const Float3& aMax, const Float3& bMin, const Float3& bMax) noexcept
+{
+	return aMin.x < bMax.x && aMax.x > bMin.x &&
+		aMin.y < bMax.y && aMax.y > bMin.y &&
+		aMin.z < bMax.z && aMax.z > bMin.z;
+}
+
+CollisionSystem::Response CollisionSystem::CalculateResponse(
+	const Float3& aMin, const Float3& aMax,
+	const Float3& bMin, const Float3& bMax,
+	const Float3& aCenter, const Float3& bCenter) noexcept
+{
+	float xPositive = bCenter.x - aCenter.x;
+	float xNegative = aCenter.x - bCenter.x;
+
+	float yPositive = bCenter.y - aCenter.y;
+	float yNegative = aCenter.y - bCenter.y;
+
+	float zPositive = bCenter.z - aCenter.z;
+	float zNegative = aCenter.z - bCenter.z;
+
+	float entryAxis = (std::max)((std::max)((std::max)(xPositive, xNegative), (std::max)(yPositive, yNegative)), (std::max)(zPositive, zNegative));
+
+	//Distance of the intesection of two objects for each axis
+	float xEntryDistance = (xPositive > xNegative) ? bMin.x - aMax.x : bMax.x - aMin.x;
+	float yEntryDistance = (yPositive > yNegative) ? bMin.y - aMax.y : bMax.y - aMin.y;
+	float zEntryDistance = (zPositive > zNegative) ? bMin.z - aMax.z : bMax.z - aMin.z;
+
+	Response response;
+	if (yPositive == entryAxis || yNegative == entryAxis)
+	{
+		response.stopY = true;
+		response.grounded = true;
+		response.push.y = yEntryDistance;
+	}
+
+	float aHeight = aMax.y - aMin.y;
+
+	//Don't check side collisions on objects beneath the player
+	if (aCenter.y - (aHeight / 2) < bCenter.y)
+	{
+		if (xPositive == entryAxis || xNegative == entryAxis)
+		{
+			response.stopX = true;
+			response.push.x = xEntryDistance;
+		}
+
+		if (zPositive == entryAxis || zNegative == entryAxis)
+		{
+			response.stopZ = true;
+			response.push.z = zEntryDistance;
+		}
+	}
+
+	return response;
+}
+
+void CollisionSystem::FindOverlaps(const Registry& registry, const Float3& boxMin, const Float3& boxMax, ColliderType type, std::vector<Entity>& overlaps)
+{
+	overlaps.clear();
+	uint64_t tests = 0;
+
+	for (size_t i = 0; i < registry.colliders.GetSize(); i++)
+	{
+		if (registry.colliders.GetAt(i).type != type)
+		{
+			continue;
+		}
+		tests++;
+
+		const Entity entity = registry.colliders.GetEntityAt(i);
+		const BoundsComponent* pBounds = registry.bounds.Find(entity);
+		if (pBounds != nullptr && CheckOverlap(boxMin, boxMax, pBounds->worldMin, pBounds->worldMax))
+		{
+			overlaps.push_back(entity);
+		}
+	}
+	PerfCounters::Add(PerfCounters::CollisionTestCounter, tests);
+}
+
+bool TriggerSystem::Fire(Registry& registry, const std::vector<Entity>& overlaps) noexcept
+{
+	bool goalReached = false;
+
+	for (const Entity entity : overlaps)
+	{
+		TriggerComponent* pTrigger = registry.triggers.Find(entity);
+		if (pTrigger == nullptr || pTrigger->fired)
+		{
+			continue;
+		}
+
+		switch (pTrigger->action)
+		{
+		case CollectTrigger:
+			if (RenderableComponent* pRenderable = registry.renderables.Find(entity))
+			{
+				pRenderable->visible = false;
+			}
+			pTrigger->fired = true;
+			break;
+
+		case ActivateGroupTrigger:
+			AnimationSystem::Activate(registry, entity);
+			AnimationSystem::ActivateGroup(registry, pTrigger->targetGroup);
+			pTrigger->fired = true;
+			break;
+
+		case GoalTrigger:
+			goalReached = true;
+			break;
+		}
+	}
+	return goalReached;
+}
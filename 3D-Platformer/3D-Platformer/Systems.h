@@ -0,0 +1,50 @@
+#pragma once
+#include "Registry.h"
+#include <vector>
+
+//Systems hold no state, each one walks the packed array of the component it is driven by from start to end
+
+class AnimationSystem
+{
+public:
+	static void Update(Registry& registry, float dt) noexcept;
+	static void Activate(Registry& registry, Entity entity) noexcept;
+	static void ActivateGroup(Registry& registry, AnimatorGroup group) noexcept;
+};
+
+//Driven by the registry's dirty list rather than a component array, so entities that have not moved cost nothing
+//Update gathers the dirty entities into the registry's TransformBatch and rebuilds them together
+//CalculateWorld and CalculateWorldBounds are the same maths for a single entity
+class TransformSystem
+{
+public:
+	static void Update(Registry& registry);
+	static void CalculateWorld(const TransformComponent& transform, WorldComponent& world) noexcept;
+	static void CalculateWorldBounds(const WorldComponent& world, BoundsComponent& bounds) noexcept;
+};
+
+class CollisionSystem
+{
+public:
+	//How the player is pushed out of a box it overlaps, which axes of its velocity stop and whether it landed on the box
+	struct Response
+	{
+		Float3 push;
+		bool stopX = false;
+		bool stopY = false;
+		bool stopZ = false;
+		bool grounded = false;
+	};
+public:
+	static bool CheckOverlap(const Float3& aMin, const Float3& aMax, const Float3& bMin, const Float3& bMax) noexcept;
+	//Box a is pushed out along the axis its centre is furthest from b's centre, sideways only if a is not standing on b
+	static Response CalculateResponse(const Float3& aMin, const Float3& aMax, const Float3& bMin, const Float3& bMax, const Float3& aCenter, const Float3& bCenter) noexcept;
+	static void FindOverlaps(const Registry& registry, const Float3& boxMin, const Float3& boxMax, ColliderType type, std::vector<Entity>& overlaps);
+};
+
+class TriggerSystem
+{
+public:
+	//Fires the triggers among the overlapping entities, returns true if one of them was a goal
+	static bool Fire(Registry& registry, const std::vector<Entity>& overlaps) noexcept;
+};
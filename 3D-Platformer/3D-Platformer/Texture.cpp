@@ -1,8 +1,75 @@
 #include "Texture.h"
+#include "MemoryTracker.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+
+//Formats the WIC loader can create, anything else is counted as four bytes a pixel
+static size_t GetBitsPerPixel(DXGI_FORMAT format) noexcept
+{
+	switch (format)
+	{
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		return 128;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT:
+	case DXGI_FORMAT_R16G16B16A16_UNORM:
+		return 64;
+	case DXGI_FORMAT_R16_FLOAT:
+	case DXGI_FORMAT_R16_UNORM:
+	case DXGI_FORMAT_B5G5R5A1_UNORM:
+	case DXGI_FORMAT_B5G6R5_UNORM:
+		return 16;
+	case DXGI_FORMAT_R8_UNORM:
+	case DXGI_FORMAT_A8_UNORM:
+		return 8;
+	case DXGI_FORMAT_R1_UNORM:
+		return 1;
+	default:
+		return 32;
+	}
+}
+
+//Bytes of every mip level of the texture behind a view
+static size_t GetTextureBytes(ID3D11ShaderResourceView* pView)
+{
+	ID3D11Resource* pResource = nullptr;
+	pView->GetResource(&pResource);
+
+	size_t bytes = 0;
+	ID3D11Texture2D* pTexture = nullptr;
+	if (SUCCEEDED(pResource->QueryInterface(__uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&pTexture))))
+	{
+		D3D11_TEXTURE2D_DESC desc;
+		pTexture->GetDesc(&desc);
+		for (UINT mip = 0; mip < desc.MipLevels; mip++)
+		{
+			const size_t pixels = size_t((std::max)(desc.Width >> mip, 1u)) * (std::max)(desc.Height >> mip, 1u);
+			bytes += (pixels * GetBitsPerPixel(desc.Format) + 7) / 8;
+		}
+		bytes *= desc.ArraySize;
+		pTexture->Release();
+	}
+	pResource->Release();
+	return bytes;
+}
 
 Texture::Texture(Graphics& gfx, const std::wstring& textureName)
 {
-	DirectX::CreateWICTextureFromFile(GetDevice(gfx), textureName.c_str(), nullptr, &pTextureView);
+	PROFILE_SCOPE("Load texture");
+
+	//Decode straight from the file data, which is zero copy when it comes from the asset archive
+	const VirtualFile file = VirtualFileSystem::Open(textureName);
+	if (file.IsValid())
+	{
+		DirectX::CreateWICTextureFromMemory(GetDevice(gfx), file.GetData(), file.GetSize(), nullptr, &pTextureView);
+	}
+	if (pTextureView != nullptr)
+	{
+		byteSize = GetTextureBytes(pTextureView);
+		MemoryTracker::Add(MemoryTracker::TextureCategory, byteSize);
+		PerfCounters::Add(PerfCounters::TextureLoadCounter);
+	}
 
 	// Create the sample state
 	D3D11_SAMPLER_DESC sampDesc;
@@ -22,6 +89,7 @@ Texture::~Texture()
 	if (pTextureView != nullptr)
 	{
 		pTextureView->Release();
+		MemoryTracker::Remove(MemoryTracker::TextureCategory, byteSize);
 	}
 
 	if (pSamplerPoint != nullptr)
@@ -12,4 +12,5 @@ public:
 protected:
 	ID3D11ShaderResourceView* pTextureView = nullptr;
 	ID3D11SamplerState* pSamplerPoint = nullptr;
+	size_t byteSize = 0;
 };
\ No newline at end of file
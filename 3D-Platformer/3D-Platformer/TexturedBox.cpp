@@ -142,7 +142,7 @@ TexturedBox::TexturedBox(Graphics& gfx, std::wstring _textureName, float _x, flo
 	}
 
 	//Bind transform buffer
-	AddBind(std::make_unique<TransformCbuf>(gfx, *this));
+	AddBind(std::make_unique<TransformCbuf>(gfx));
 
 	//Model deformation transform (Instance)
 	DirectX::XMStoreFloat3x3(
@@ -157,7 +157,7 @@ TexturedBox::TexturedBox(Graphics& gfx, std::wstring _textureName, float _x, flo
 	}
 	
 	CreateBoundingBox(verticePositions);
-	CalculateAABB(GetTransformXM());
+	MarkTransformDirty();
 }
 
 void TexturedBox::Update(float dt) noexcept
@@ -0,0 +1,34 @@
+#include "TileRecord.h"
+
+static const TileShape tileShapes[TileKindCount] =
+{
+	//Unit cube centred on the tile position, same as TexturedBox
+	{ { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f }, L"platform.png" }
+};
+
+const TileShape& TileShape::Get(TileKind kind) noexcept
+{
+	return tileShapes[kind];
+}
+
+DirectX::XMVECTOR TileRecord::GetBBMinVertex() const noexcept
+{
+	const TileShape& shape = TileShape::Get(kind);
+	return DirectX::XMVectorSet(position.x + shape.boundsMin.x, position.y + shape.boundsMin.y, position.z + shape.boundsMin.z, 0.0f);
+}
+
+DirectX::XMVECTOR TileRecord::GetBBMaxVertex() const noexcept
+{
+	const TileShape& shape = TileShape::Get(kind);
+	return DirectX::XMVectorSet(position.x + shape.boundsMax.x, position.y + shape.boundsMax.y, position.z + shape.boundsMax.z, 0.0f);
+}
+
+DirectX::XMVECTOR TileRecord::GetCenterVertex() const noexcept
+{
+	const TileShape& shape = TileShape::Get(kind);
+	return DirectX::XMVectorSet(
+		position.x + (shape.boundsMin.x + shape.boundsMax.x) * 0.5f,
+		position.y + (shape.boundsMin.y + shape.boundsMax.y) * 0.5f,
+		position.z + (shape.boundsMin.z + shape.boundsMax.z) * 0.5f,
+		0.0f);
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <DirectXMath.h>
+#include <cstdint>
+
+enum TileKind : uint8_t
+{
+	PlatformTile,
+	TileKindCount
+};
+
+//Geometry shared by every tile of a kind, in model space
+struct TileShape
+{
+	DirectX::XMFLOAT3 boundsMin;
+	DirectX::XMFLOAT3 boundsMax;
+	const wchar_t* textureName;
+
+	static const TileShape& Get(TileKind kind) noexcept;
+};
+
+//A static tile is only a position and a kind, everything else comes from its TileShape
+struct TileRecord
+{
+	DirectX::XMFLOAT3 position;
+	TileKind kind;
+	uint8_t flags;
+	uint16_t reserved;
+
+	DirectX::XMVECTOR GetBBMinVertex() const noexcept;
+	DirectX::XMVECTOR GetBBMaxVertex() const noexcept;
+	DirectX::XMVECTOR GetCenterVertex() const noexcept;
+};
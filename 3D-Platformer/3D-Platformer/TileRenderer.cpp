@@ -0,0 +1,16 @@
+#include "TileRenderer.h"
+
+TileRenderer::TileRenderer(Graphics& gfx)
+{
+	pPlatform = std::make_unique<TexturedBox>(gfx, TileShape::Get(PlatformTile).textureName, 0.0f, 0.0f, 0.0f);
+}
+
+void TileRenderer::Draw(Graphics& gfx, const TileRecord* pTiles, size_t count) const
+{
+	for (size_t i = 0; i < count; i++)
+	{
+		//Tiles are neither rotated nor scaled, so the world matrix is only a translation
+		const TileRecord& tile = pTiles[i];
+		pPlatform->Draw(gfx, DirectX::XMMatrixTranslation(tile.position.x, tile.position.y, tile.position.z));
+	}
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "Graphics.h"
+#include "TileRecord.h"
+#include "TexturedBox.h"
+#include <memory>
+
+//Draws tile records with one shared object per tile kind
+//The object owns the kind's vertex buffer, texture and shaders and is drawn with each tile's world matrix in turn
+class TileRenderer
+{
+public:
+	TileRenderer(Graphics& gfx);
+	void Draw(Graphics& gfx, const TileRecord* pTiles, size_t count) const;
+private:
+	std::unique_ptr<TexturedBox> pPlatform;
+};
@@ -11,10 +11,6 @@ float Timer::Mark() noexcept
 	const auto old = last;
 	last = std::chrono::steady_clock::now();
 	const std::chrono::duration<float> frameTime = last - old;
-
-
-	std::string fps = "fps: " + std::to_string(1.0f / frameTime.count()) + "\n";
-	OutputDebugStringA(fps.c_str());
 	return frameTime.count();
 }
 
@@ -1,7 +1,5 @@
 #pragma once
 #include <chrono>
-#include <Windows.h>
-#include <string>
 
 class Timer
 {
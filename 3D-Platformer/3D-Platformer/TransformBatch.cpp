@@ -0,0 +1,111 @@
+#include "TransformBatch.h"
+#include "JobSystem.h"
+#include <DirectXMath.h>
+
+static DirectX::XMVECTOR Load(const std::vector<float>& stream, size_t index) noexcept
+{
+	return DirectX::XMLoadFloat4(reinterpret_cast<const DirectX::XMFLOAT4*>(&stream[index]));
+}
+
+static void Store(std::vector<float>& stream, size_t index, DirectX::FXMVECTOR value) noexcept
+{
+	DirectX::XMStoreFloat4(reinterpret_cast<DirectX::XMFLOAT4*>(&stream[index]), value);
+}
+
+void TransformBatch::Resize(size_t _count)
+{
+	count = _count;
+	const size_t paddedCount = (count + 3) & ~size_t(3);
+
+	for (std::vector<float>* pStream : {
+		&positionX, &positionY, &positionZ, &rotationX, &rotationY, &rotationZ,
+		&modelCenterX, &modelCenterY, &modelCenterZ, &modelExtentX, &modelExtentY, &modelExtentZ,
+		&axisXX, &axisXY, &axisXZ, &axisYX, &axisYY, &axisYZ, &axisZX, &axisZY, &axisZZ,
+		&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ })
+	{
+		pStream->resize(paddedCount, 0.0f);
+	}
+	for (std::vector<float>* pStream : { &scaleX, &scaleY, &scaleZ })
+	{
+		pStream->resize(paddedCount, 1.0f);
+	}
+}
+
+size_t TransformBatch::GetCount() const noexcept
+{
+	return count;
+}
+
+void TransformBatch::Run()
+{
+	const size_t paddedCount = (count + 3) & ~size_t(3);
+	if (count < parallelThreshold || JobSystem::GetThreadCount() == 1)
+	{
+		Run(0, paddedCount);
+		return;
+	}
+
+	//Slices are whole SIMD groups, so no two jobs write the same four floats
+	JobSystem::ParallelFor(paddedCount, jobBatchSize, [this](size_t begin, size_t end) { Run(begin, end); });
+}
+
+//Same matrix as GameObject::GetTransformXM and the same box as GameObject::CalculateAABB, for the objects in [begin, end)
+//begin and end must be multiples of four
+void TransformBatch::Run(size_t begin, size_t end) noexcept
+{
+	namespace dx = DirectX;
+
+	for (size_t i = begin; i < end; i += 4)
+	{
+		dx::XMVECTOR sinPitch, cosPitch, sinYaw, cosYaw, sinRoll, cosRoll;
+		dx::XMVectorSinCos(&sinPitch, &cosPitch, Load(rotationX, i));
+		dx::XMVectorSinCos(&sinYaw, &cosYaw, Load(rotationY, i));
+		dx::XMVectorSinCos(&sinRoll, &cosRoll, Load(rotationZ, i));
+
+		const dx::XMVECTOR sx = Load(scaleX, i);
+		const dx::XMVECTOR sy = Load(scaleY, i);
+		const dx::XMVECTOR sz = Load(scaleZ, i);
+
+		//Rows of scale * roll pitch yaw rotation
+		const dx::XMVECTOR sinRollSinPitch = dx::XMVectorMultiply(sinRoll, sinPitch);
+		const dx::XMVECTOR cosRollSinPitch = dx::XMVectorMultiply(cosRoll, sinPitch);
+
+		const dx::XMVECTOR xx = dx::XMVectorMultiply(dx::XMVectorMultiplyAdd(sinRollSinPitch, sinYaw, dx::XMVectorMultiply(cosRoll, cosYaw)), sx);
+		const dx::XMVECTOR xy = dx::XMVectorMultiply(dx::XMVectorMultiply(sinRoll, cosPitch), sx);
+		const dx::XMVECTOR xz = dx::XMVectorMultiply(dx::XMVectorNegativeMultiplySubtract(cosRoll, sinYaw, dx::XMVectorMultiply(sinRollSinPitch, cosYaw)), sx);
+
+		const dx::XMVECTOR yx = dx::XMVectorMultiply(dx::XMVectorNegativeMultiplySubtract(sinRoll, cosYaw, dx::XMVectorMultiply(cosRollSinPitch, sinYaw)), sy);
+		const dx::XMVECTOR yy = dx::XMVectorMultiply(dx::XMVectorMultiply(cosRoll, cosPitch), sy);
+		const dx::XMVECTOR yz = dx::XMVectorMultiply(dx::XMVectorMultiplyAdd(sinRoll, sinYaw, dx::XMVectorMultiply(cosRollSinPitch, cosYaw)), sy);
+
+		const dx::XMVECTOR zx = dx::XMVectorMultiply(dx::XMVectorMultiply(cosPitch, sinYaw), sz);
+		const dx::XMVECTOR zy = dx::XMVectorMultiply(dx::XMVectorNegate(sinPitch), sz);
+		const dx::XMVECTOR zz = dx::XMVectorMultiply(dx::XMVectorMultiply(cosPitch, cosYaw), sz);
+
+		Store(axisXX, i, xx);
+		Store(axisXY, i, xy);
+		Store(axisXZ, i, xz);
+		Store(axisYX, i, yx);
+		Store(axisYY, i, yy);
+		Store(axisYZ, i, yz);
+		Store(axisZX, i, zx);
+		Store(axisZY, i, zy);
+		Store(axisZZ, i, zz);
+
+		//World box from the model box's centre and half extents
+		const dx::XMVECTOR mcx = Load(modelCenterX, i);
+		const dx::XMVECTOR mcy = Load(modelCenterY, i);
+		const dx::XMVECTOR mcz = Load(modelCenterZ, i);
+		const dx::XMVECTOR mex = Load(modelExtentX, i);
+		const dx::XMVECTOR mey = Load(modelExtentY, i);
+		const dx::XMVECTOR mez = Load(modelExtentZ, i);
+
+		Store(centerX, i, dx::XMVectorMultiplyAdd(mcz, zx, dx::XMVectorMultiplyAdd(mcy, yx, dx::XMVectorMultiplyAdd(mcx, xx, Load(positionX, i)))));
+		Store(centerY, i, dx::XMVectorMultiplyAdd(mcz, zy, dx::XMVectorMultiplyAdd(mcy, yy, dx::XMVectorMultiplyAdd(mcx, xy, Load(positionY, i)))));
+		Store(centerZ, i, dx::XMVectorMultiplyAdd(mcz, zz, dx::XMVectorMultiplyAdd(mcy, yz, dx::XMVectorMultiplyAdd(mcx, xz, Load(positionZ, i)))));
+
+		Store(extentX, i, dx::XMVectorMultiplyAdd(mez, dx::XMVectorAbs(zx), dx::XMVectorMultiplyAdd(mey, dx::XMVectorAbs(yx), dx::XMVectorMultiply(mex, dx::XMVectorAbs(xx)))));
+		Store(extentY, i, dx::XMVectorMultiplyAdd(mez, dx::XMVectorAbs(zy), dx::XMVectorMultiplyAdd(mey, dx::XMVectorAbs(yy), dx::XMVectorMultiply(mex, dx::XMVectorAbs(xy)))));
+		Store(extentZ, i, dx::XMVectorMultiplyAdd(mez, dx::XMVectorAbs(zz), dx::XMVectorMultiplyAdd(mey, dx::XMVectorAbs(yz), dx::XMVectorMultiply(mex, dx::XMVectorAbs(xz)))));
+	}
+}
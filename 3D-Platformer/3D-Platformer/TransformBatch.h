@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+//Builds world matrices and world bounding boxes for many objects at once
+//Inputs and outputs are kept as one array per component (structure of arrays), so four objects are transformed per SIMD instruction
+//The arrays are padded to a multiple of four, padding lanes are computed and ignored
+class TransformBatch
+{
+public:
+	//Below this many objects the batch runs on the calling thread, above it the work is split into jobs of jobBatchSize objects
+	static constexpr size_t parallelThreshold = 16384;
+	static constexpr size_t jobBatchSize = 4096;
+public:
+	void Resize(size_t count);
+	size_t GetCount() const noexcept;
+	void Run();
+	void Run(size_t begin, size_t end) noexcept;
+public:
+	//Inputs
+	std::vector<float> positionX, positionY, positionZ;
+	std::vector<float> rotationX, rotationY, rotationZ;
+	std::vector<float> scaleX, scaleY, scaleZ;
+	std::vector<float> modelCenterX, modelCenterY, modelCenterZ;
+	std::vector<float> modelExtentX, modelExtentY, modelExtentZ;
+
+	//Outputs, the rows of the world matrix and the centre and half extents of the world bounding box
+	std::vector<float> axisXX, axisXY, axisXZ;
+	std::vector<float> axisYX, axisYY, axisYZ;
+	std::vector<float> axisZX, axisZY, axisZZ;
+	std::vector<float> centerX, centerY, centerZ;
+	std::vector<float> extentX, extentY, extentZ;
+private:
+	size_t count = 0;
+};
@@ -1,6 +1,6 @@
 #include "TransformCbuf.h"
 
-TransformCbuf::TransformCbuf(Graphics& gfx, const GameObject& parent, UINT slot) : parent(parent)
+TransformCbuf::TransformCbuf(Graphics& gfx, UINT slot)
 {
 	if (!pVcbuf)
 	{
@@ -10,7 +10,7 @@ TransformCbuf::TransformCbuf(Graphics& gfx, const GameObject& parent, UINT slot)
 
 void TransformCbuf::Bind(Graphics& gfx) noexcept
 {
-	DirectX::XMMATRIX model = parent.GetTransformXM();
+	DirectX::XMMATRIX model = gfx.GetWorld();
 	Transforms transforms =
 	{
 		DirectX::XMMatrixTranspose(model),
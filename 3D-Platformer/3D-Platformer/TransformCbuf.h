@@ -12,9 +12,9 @@ private:
 		DirectX::XMMATRIX model;
 	};
 public:
-	TransformCbuf(Graphics& gfx, const GameObject& parent, UINT slot = 0u);
+	TransformCbuf(Graphics& gfx, UINT slot = 0u);
+	//Uploads the world matrix the object is being drawn with, set on gfx by GameObject::Draw
 	void Bind(Graphics& gfx) noexcept override;
 private:
 	static std::unique_ptr<VertexConstantBuffer<Transforms>> pVcbuf;
-	const GameObject& parent;
 };
\ No newline at end of file
@@ -12,14 +12,15 @@
 
 Trigger::Trigger(Graphics& gfx, std::wstring _textureName, float _x, float _y, float _z, float _xScale, float _yScale, float _zScale) :
 	textureName(_textureName),
-	xPos(_x),
-	yPos(_y),
-	yTarget(_y),
-	zPos(_z),
-	xScale(_xScale),
-	yScale(_yScale),
-	zScale(_zScale)
+	yTarget(_y)
 {
+	xPos = _x;
+	yPos = _y;
+	zPos = _z;
+	xScale = _xScale;
+	yScale = _yScale;
+	zScale = _zScale;
+
 	//Create the vertex buffer
 	const float side = 0.5f;
 	vertices = std::vector<Vertex>
@@ -145,7 +146,7 @@ Trigger::Trigger(Graphics& gfx, std::wstring _textureName, float _x, float _y, f
 	}
 
 	//Bind transform buffer
-	AddBind(std::make_unique<TransformCbuf>(gfx, *this));
+	AddBind(std::make_unique<TransformCbuf>(gfx));
 
 	//Model deformation transform (Instance)
 	DirectX::XMStoreFloat3x3(
@@ -160,14 +161,7 @@ Trigger::Trigger(Graphics& gfx, std::wstring _textureName, float _x, float _y, f
 	}
 
 	CreateBoundingBox(verticePositions);
-	CalculateAABB(GetTransformXM());
-}
-
-void Trigger::SetPosition(float _x, float _y, float _z)
-{
-	xPos = _x;
-	yPos = _y;
-	zPos = _z;
+	MarkTransformDirty();
 }
 
 void Trigger::MoveTowards(float _yTarget, float _speed)
@@ -179,16 +173,19 @@ void Trigger::MoveTowards(float _yTarget, float _speed)
 void Trigger::SetEularX(float angle)
 {
 	xRot = angle;
+	MarkTransformDirty();
 }
 
 void Trigger::SetEularY(float angle)
 {
 	yRot = angle;
+	MarkTransformDirty();
 }
 
 void Trigger::SetEularZ(float angle)
 {
 	zRot = angle;
+	MarkTransformDirty();
 }
 
 bool Trigger::IsActivated()
@@ -224,6 +221,8 @@ void Trigger::Update(float dt) noexcept
 				yPos = yTarget;
 			}
 		}
+
+		MarkTransformDirty();
 	}
 }
 
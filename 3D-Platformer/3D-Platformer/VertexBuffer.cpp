@@ -5,6 +5,7 @@ VertexBuffer::~VertexBuffer()
 	if (pVertexBuffer != nullptr)
 	{
 		pVertexBuffer->Release();
+		MemoryTracker::Remove(MemoryTracker::VertexBufferCategory, byteSize);
 	}
 }
 
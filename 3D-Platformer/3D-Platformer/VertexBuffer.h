@@ -1,5 +1,6 @@
 #pragma once
 #include "Bindable.h"
+#include "MemoryTracker.h"
 
 class VertexBuffer : public Bindable
 {
@@ -18,11 +19,18 @@ public:
 		D3D11_SUBRESOURCE_DATA vertexBufferData = {};										//Clear the memory in the vertex buffer
 		vertexBufferData.pSysMem = vertices.data();											//The data to place into the buffer		
 		GetDevice(gfx)->CreateBuffer(&vertexBufferDesc, &vertexBufferData, &pVertexBuffer);	//Create the buffer
+
+		if (pVertexBuffer != nullptr)
+		{
+			byteSize = vertexBufferDesc.ByteWidth;
+			MemoryTracker::Add(MemoryTracker::VertexBufferCategory, byteSize);
+		}
 	}
 	~VertexBuffer();
 
 	void Bind(Graphics& gfx) noexcept override;
 protected:
 	UINT stride;
+	UINT byteSize = 0u;
 	ID3D11Buffer* pVertexBuffer = nullptr;
 };
\ No newline at end of file
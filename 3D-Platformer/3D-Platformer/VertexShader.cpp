@@ -1,9 +1,15 @@
 #include "VertexShader.h"
+#include "VirtualFileSystem.h"
+#include <cstring>
 
 VertexShader::VertexShader(Graphics& gfx, const std::wstring& path)
 {
+	//Keep a copy of the bytecode in a blob as the input layout needs it after the file is released
+	const VirtualFile file = VirtualFileSystem::Open(path);
+	D3DCreateBlob(file.GetSize(), &pBytecodeBlob);
+	memcpy(pBytecodeBlob->GetBufferPointer(), file.GetData(), file.GetSize());
+
 	//Create vertex shader
-	D3DReadFileToBlob(path.c_str(), &pBytecodeBlob);
 	GetDevice(gfx)->CreateVertexShader(pBytecodeBlob->GetBufferPointer(), pBytecodeBlob->GetBufferSize(), nullptr, &pVertexShader);
 }
 
@@ -0,0 +1,72 @@
+#include "VirtualFile.h"
+#include <utility>
+
+VirtualFile::VirtualFile(const uint8_t* pView, size_t viewSize) :
+	pData(pView),
+	size(viewSize),
+	valid(true)
+{
+}
+
+VirtualFile::VirtualFile(std::vector<uint8_t> data) :
+	size(data.size()),
+	valid(true),
+	buffer(std::move(data))
+{
+	pData = buffer.data();
+}
+
+VirtualFile::VirtualFile(VirtualFile&& other) noexcept
+{
+	*this = std::move(other);
+}
+
+//Moving a vector keeps its storage, so pData stays valid when it points at buffer
+VirtualFile& VirtualFile::operator=(VirtualFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		pData = std::exchange(other.pData, nullptr);
+		size = std::exchange(other.size, 0);
+		valid = std::exchange(other.valid, false);
+		buffer = std::move(other.buffer);
+		other.buffer.clear();
+	}
+	return *this;
+}
+
+bool VirtualFile::IsValid() const noexcept
+{
+	return valid;
+}
+
+const uint8_t* VirtualFile::GetData() const noexcept
+{
+	return pData;
+}
+
+size_t VirtualFile::GetSize() const noexcept
+{
+	return size;
+}
+
+std::string VirtualFile::ToString() const
+{
+	if (pData == nullptr)
+	{
+		return std::string();
+	}
+	return std::string(reinterpret_cast<const char*>(pData), size);
+}
+
+//Widens each byte, matching how std::wifstream reads files in the default locale
+std::wstring VirtualFile::ToWideString() const
+{
+	std::wstring text;
+	text.resize(size);
+	for (size_t i = 0; i < size; i++)
+	{
+		text[i] = static_cast<wchar_t>(pData[i]);
+	}
+	return text;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Read only contents of a game file returned by the VirtualFileSystem
+//Either a view into memory owned by a mount (such as a mapped archive) or an owned buffer
+class VirtualFile
+{
+public:
+	VirtualFile() = default;
+	VirtualFile(const uint8_t* pView, size_t viewSize);
+	VirtualFile(std::vector<uint8_t> data);
+	VirtualFile(const VirtualFile&) = delete;
+	VirtualFile& operator=(const VirtualFile&) = delete;
+	VirtualFile(VirtualFile&& other) noexcept;
+	VirtualFile& operator=(VirtualFile&& other) noexcept;
+
+	bool IsValid() const noexcept;
+	const uint8_t* GetData() const noexcept;
+	size_t GetSize() const noexcept;
+	std::string ToString() const;
+	std::wstring ToWideString() const;
+private:
+	//Either points into memory owned by a mount or at buffer
+	const uint8_t* pData = nullptr;
+	size_t size = 0;
+	bool valid = false;
+	std::vector<uint8_t> buffer;
+};
@@ -0,0 +1,187 @@
+#include "VirtualFileSystem.h"
+#include "FilePath.h"
+#include "PerfCounters.h"
+#include "Profiler.h"
+#include <chrono>
+
+VirtualFileSystem VirtualFileSystem::vfs;
+
+VirtualFileSystem::VirtualFileSystem() :
+	cache(defaultCacheSize)
+{
+}
+
+VirtualFileSystem::~VirtualFileSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(requestMutex);
+		stopping = true;
+	}
+	requestCondition.notify_all();
+
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+void VirtualFileSystem::Mount(const std::string& mountPoint, std::unique_ptr<FileMount> pMount)
+{
+	std::unique_lock<std::shared_mutex> lock(vfs.mountMutex);
+	vfs.mounts.push_back({ FilePath::Normalise(mountPoint), std::move(pMount) });
+}
+
+//Files returned as views of a mount must not outlive it
+void VirtualFileSystem::UnmountAll()
+{
+	std::unique_lock<std::shared_mutex> lock(vfs.mountMutex);
+	vfs.mounts.clear();
+	vfs.cache.Clear();
+}
+
+bool VirtualFileSystem::Exists(const std::string& path)
+{
+	const std::string normalisedPath = FilePath::Normalise(path);
+
+	std::shared_lock<std::shared_mutex> lock(vfs.mountMutex);
+	for (auto it = vfs.mounts.rbegin(); it != vfs.mounts.rend(); ++it)
+	{
+		if (FilePath::HasPrefix(normalisedPath, it->prefix) &&
+			it->pMount->Exists(normalisedPath.substr(it->prefix.empty() ? 0 : it->prefix.size() + 1)))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+VirtualFile VirtualFileSystem::Open(const std::string& path)
+{
+	return vfs.Read(path);
+}
+
+VirtualFile VirtualFileSystem::Open(const std::wstring& path)
+{
+	return vfs.Read(FilePath::Normalise(path));
+}
+
+std::future<VirtualFile> VirtualFileSystem::OpenAsync(const std::string& path)
+{
+	Request request;
+	request.path = path;
+	std::future<VirtualFile> result = request.promise.get_future();
+
+	{
+		std::lock_guard<std::mutex> lock(vfs.requestMutex);
+		if (!vfs.worker.joinable())
+		{
+			vfs.worker = std::thread(&VirtualFileSystem::WorkerLoop, &vfs);
+		}
+		vfs.requests.push_back(std::move(request));
+	}
+	vfs.requestCondition.notify_one();
+
+	vfs.asyncRequestCount++;
+	return result;
+}
+
+VirtualFileSystem::Stats VirtualFileSystem::GetStats()
+{
+	Stats stats = {};
+	stats.openCount = vfs.openCount;
+	stats.failedOpenCount = vfs.failedOpenCount;
+	stats.asyncRequestCount = vfs.asyncRequestCount;
+	stats.bytesRead = vfs.bytesRead;
+	stats.cacheHits = vfs.cache.GetHitCount() - vfs.cacheHitsAtReset;
+	stats.cacheMisses = vfs.cache.GetMissCount() - vfs.cacheMissesAtReset;
+	stats.totalReadMilliseconds = vfs.totalReadMicroseconds / 1000.0;
+	stats.maxReadMilliseconds = vfs.maxReadMicroseconds / 1000.0;
+	return stats;
+}
+
+void VirtualFileSystem::ResetStats()
+{
+	vfs.openCount = 0;
+	vfs.failedOpenCount = 0;
+	vfs.asyncRequestCount = 0;
+	vfs.bytesRead = 0;
+	vfs.totalReadMicroseconds = 0;
+	vfs.maxReadMicroseconds = 0;
+	vfs.cacheHitsAtReset = vfs.cache.GetHitCount();
+	vfs.cacheMissesAtReset = vfs.cache.GetMissCount();
+}
+
+BlockCache& VirtualFileSystem::GetCache() noexcept
+{
+	return vfs.cache;
+}
+
+VirtualFile VirtualFileSystem::Read(const std::string& path)
+{
+	PROFILE_SCOPE("File read");
+	const auto start = std::chrono::steady_clock::now();
+	const std::string normalisedPath = FilePath::Normalise(path);
+	VirtualFile file;
+
+	{
+		//Mounted last takes priority so patches and mods can override earlier data
+		std::shared_lock<std::shared_mutex> lock(mountMutex);
+		for (auto it = mounts.rbegin(); it != mounts.rend(); ++it)
+		{
+			if (!FilePath::HasPrefix(normalisedPath, it->prefix))
+			{
+				continue;
+			}
+
+			const std::string relativePath = normalisedPath.substr(it->prefix.empty() ? 0 : it->prefix.size() + 1);
+			if (it->pMount->Read(relativePath, cache, file))
+			{
+				break;
+			}
+		}
+	}
+
+	const uint64_t elapsed = static_cast<uint64_t>(
+		std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+	openCount++;
+	totalReadMicroseconds += elapsed;
+	uint64_t previousMax = maxReadMicroseconds;
+	while (previousMax < elapsed && !maxReadMicroseconds.compare_exchange_weak(previousMax, elapsed))
+	{
+	}
+
+	if (file.IsValid())
+	{
+		bytesRead += file.GetSize();
+		PerfCounters::Add(PerfCounters::FileReadCounter);
+		PerfCounters::Add(PerfCounters::FileBytesCounter, file.GetSize());
+	}
+	else
+	{
+		failedOpenCount++;
+	}
+	return file;
+}
+
+void VirtualFileSystem::WorkerLoop()
+{
+	PROFILE_THREAD("File I/O");
+
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(requestMutex);
+			requestCondition.wait(lock, [this]() { return stopping || !requests.empty(); });
+			if (requests.empty())
+			{
+				return;
+			}
+			request = std::move(requests.front());
+			requests.pop_front();
+		}
+
+		request.promise.set_value(Read(request.path));
+	}
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "BlockCache.h"
+#include "FileMount.h"
+#include "VirtualFile.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Single entry point for every file the game reads
+//Paths are normalised, matched against mount points (latest mount first) and read through a shared block cache
+class VirtualFileSystem
+{
+public:
+	struct Stats
+	{
+		uint64_t openCount;
+		uint64_t failedOpenCount;
+		uint64_t asyncRequestCount;
+		uint64_t bytesRead;
+		uint64_t cacheHits;
+		uint64_t cacheMisses;
+		double totalReadMilliseconds;
+		double maxReadMilliseconds;
+	};
+public:
+	static void Mount(const std::string& mountPoint, std::unique_ptr<FileMount> pMount);
+	static void UnmountAll();
+	static bool Exists(const std::string& path);
+	static VirtualFile Open(const std::string& path);
+	static VirtualFile Open(const std::wstring& path);
+	static std::future<VirtualFile> OpenAsync(const std::string& path);
+	static Stats GetStats();
+	static void ResetStats();
+	static BlockCache& GetCache() noexcept;
+private:
+	struct MountPoint
+	{
+		std::string prefix;
+		std::unique_ptr<FileMount> pMount;
+	};
+	struct Request
+	{
+		std::string path;
+		std::promise<VirtualFile> promise;
+	};
+private:
+	VirtualFileSystem();
+	~VirtualFileSystem();
+	VirtualFileSystem(const VirtualFileSystem&) = delete;
+	VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+	VirtualFile Read(const std::string& path);
+	void WorkerLoop();
+private:
+	static constexpr size_t defaultCacheSize = 16 * 1024 * 1024;
+	static VirtualFileSystem vfs;													//File system singleton
+
+	std::shared_mutex mountMutex;
+	std::vector<MountPoint> mounts;
+	BlockCache cache;
+
+	//Async reads are served in order by one I/O thread, started on the first request
+	std::mutex requestMutex;
+	std::condition_variable requestCondition;
+	std::deque<Request> requests;
+	std::thread worker;
+	bool stopping = false;
+
+	std::atomic<uint64_t> openCount = 0;
+	std::atomic<uint64_t> failedOpenCount = 0;
+	std::atomic<uint64_t> asyncRequestCount = 0;
+	std::atomic<uint64_t> bytesRead = 0;
+	std::atomic<uint64_t> totalReadMicroseconds = 0;
+	std::atomic<uint64_t> maxReadMicroseconds = 0;
+	uint64_t cacheHitsAtReset = 0;
+	uint64_t cacheMissesAtReset = 0;
+};
@@ -8,7 +8,7 @@ int CALLBACK WinMain(
 {
 	try
 	{
-		return Game{}.Start();
+		return Game{ lpCmdLine }.Start();
 	}
 	catch (const ExceptionHandler & e)
 	{
@@ -0,0 +1,123 @@
+#include "AssetPacker.h"
+#include "FilePath.h"
+#include "Lz4.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+void AssetPacker::AddFile(const std::string& path, std::vector<uint8_t> data, bool allowCompression)
+{
+	PendingEntry entry;
+	entry.name = FilePath::Normalise(path);
+	entry.hash = AssetArchive::HashPath(entry.name);
+	entry.size = data.size();
+	entry.compressed = false;
+
+	if (allowCompression && !data.empty())
+	{
+		std::vector<uint8_t> compressed;
+		Lz4::Compress(data.data(), data.size(), compressed);
+
+		if (compressed.size() <= data.size() * (1.0f - minimumSaving))
+		{
+			entry.compressed = true;
+			entry.stored = std::move(compressed);
+		}
+	}
+
+	if (!entry.compressed)
+	{
+		entry.stored = std::move(data);
+	}
+
+	entries.push_back(std::move(entry));
+}
+
+bool AssetPacker::Write(const std::string& path) const
+{
+	//Index is sorted by hash so lookups can binary search it
+	std::vector<const PendingEntry*> sorted;
+	for (const auto& entry : entries)
+	{
+		sorted.push_back(&entry);
+	}
+	std::sort(sorted.begin(), sorted.end(),
+		[](const PendingEntry* a, const PendingEntry* b) { return a->hash < b->hash || (a->hash == b->hash && a->name < b->name); });
+
+	AssetArchive::Header header = {};
+	memcpy(header.magic, "PAK1", 4);
+	header.version = AssetArchive::version;
+	header.entryCount = static_cast<uint32_t>(sorted.size());
+	header.alignment = AssetArchive::alignment;
+	header.indexOffset = sizeof(AssetArchive::Header);
+	header.namesOffset = header.indexOffset + sorted.size() * sizeof(AssetArchive::Entry);
+
+	std::vector<AssetArchive::Entry> index(sorted.size());
+	std::string names;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		index[i].hash = sorted[i]->hash;
+		index[i].storedSize = sorted[i]->stored.size();
+		index[i].size = sorted[i]->size;
+		index[i].nameOffset = static_cast<uint32_t>(names.size());
+		index[i].nameLength = static_cast<uint32_t>(sorted[i]->name.size());
+		index[i].flags = sorted[i]->compressed ? AssetArchive::Compressed : 0u;
+		index[i].reserved = 0;
+		names += sorted[i]->name;
+	}
+	header.namesSize = names.size();
+
+	//Compressed entries are packed straight after the names, uncompressed entries follow on 4K boundaries
+	uint64_t offset = header.namesOffset + header.namesSize;
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		if (sorted[i]->compressed)
+		{
+			index[i].offset = offset;
+			offset += index[i].storedSize;
+		}
+	}
+	for (size_t i = 0; i < sorted.size(); i++)
+	{
+		if (!sorted[i]->compressed)
+		{
+			offset = (offset + AssetArchive::alignment - 1) / AssetArchive::alignment * AssetArchive::alignment;
+			index[i].offset = offset;
+			offset += index[i].storedSize;
+		}
+	}
+
+	std::ofstream fileOut(path, std::ios::binary | std::ios::trunc);
+	if (!fileOut)
+	{
+		return false;
+	}
+
+	fileOut.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	fileOut.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(AssetArchive::Entry));
+	fileOut.write(names.data(), names.size());
+
+	//Write entries in file order, padding up to each aligned offset
+	std::vector<size_t> order(sorted.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [&index](size_t a, size_t b) { return index[a].offset < index[b].offset; });
+
+	uint64_t written = header.namesOffset + header.namesSize;
+	const std::vector<char> padding(AssetArchive::alignment, 0);
+	for (const size_t i : order)
+	{
+		fileOut.write(padding.data(), static_cast<std::streamsize>(index[i].offset - written));
+		fileOut.write(reinterpret_cast<const char*>(sorted[i]->stored.data()), sorted[i]->stored.size());
+		written = index[i].offset + index[i].storedSize;
+	}
+
+	return static_cast<bool>(fileOut);
+}
+
+size_t AssetPacker::GetEntryCount() const noexcept
+{
+	return entries.size();
+}
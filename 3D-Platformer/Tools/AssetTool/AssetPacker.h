@@ -0,0 +1,27 @@
+#pragma once
+#include "AssetArchive.h"
+#include <string>
+#include <vector>
+
+//Builds an AssetArchive file from in memory entries
+class AssetPacker
+{
+public:
+	void AddFile(const std::string& path, std::vector<uint8_t> data, bool allowCompression);
+	bool Write(const std::string& path) const;
+	size_t GetEntryCount() const noexcept;
+private:
+	struct PendingEntry
+	{
+		std::string name;
+		uint64_t hash;
+		uint64_t size;
+		bool compressed;
+		std::vector<uint8_t> stored;
+	};
+
+	//Entries are only kept compressed when it saves at least this fraction of their size
+	static constexpr float minimumSaving = 0.1f;
+
+	std::vector<PendingEntry> entries;
+};
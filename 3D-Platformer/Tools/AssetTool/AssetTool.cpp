@@ -0,0 +1,529 @@
+//Command line tool for building and inspecting the game's asset archive
+//
+//	AssetTool pack <archive.pak> <asset root> [--no-compress]
+//	AssetTool list <archive.pak>
+//	AssetTool bench <archive.pak> <asset root> [runs]
+//	AssetTool level-compile <LevelN.txt> <LevelN_Items.txt> <LevelN.lvl>
+//	AssetTool level-generate <LevelN.txt> <LevelN_Items.txt> [-lvl LevelN.lvl] [-size width depth] [-seed N] [-fill 0-1]
+//	                         [-heights flat|uniform|terrain] [-max-height N] [-feature cells] [-bridges 0-1] [-collectables N]
+//	AssetTool level-bench [size] [runs]
+//
+//Builds with the AssetTool project on Windows, or on Linux with
+//	g++ -std=c++17 -O2 -I../../3D-Platformer AssetTool.cpp AssetPacker.cpp ../../3D-Platformer/AssetArchive.cpp ../../3D-Platformer/FilePath.cpp ../../3D-Platformer/LevelData.cpp ../../3D-Platformer/LevelGenerator.cpp ../../3D-Platformer/Lz4.cpp ../../3D-Platformer/MappedFile.cpp ../../3D-Platformer/MemoryTracker.cpp ../../3D-Platformer/VirtualFile.cpp -o AssetTool
+
+#include "AssetArchive.h"
+#include "AssetPacker.h"
+#include "LevelData.h"
+#include "LevelGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+//Files the game loads at runtime
+static bool IsAssetFile(const fs::path& path)
+{
+	const std::string extension = path.extension().string();
+	const char* assetExtensions[] = { ".txt", ".lvl", ".obj", ".mtl", ".png", ".jpg", ".bmp", ".cso", ".spritefont" };
+	for (const char* assetExtension : assetExtensions)
+	{
+		if (extension == assetExtension)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+//Formats that are already compressed, or are used in place, are stored as is so they can be read from the mapping
+static bool IsCompressible(const fs::path& path)
+{
+	const std::string extension = path.extension().string();
+	return extension != ".png" && extension != ".jpg" && extension != ".lvl";
+}
+
+static std::vector<std::string> FindAssets(const std::string& root)
+{
+	std::vector<std::string> assets;
+	for (const auto& item : fs::recursive_directory_iterator(root))
+	{
+		if (item.is_regular_file() && IsAssetFile(item.path()))
+		{
+			assets.push_back(fs::relative(item.path(), root).generic_string());
+		}
+	}
+	std::sort(assets.begin(), assets.end());
+	return assets;
+}
+
+static bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out)
+{
+	std::ifstream fileIn(path, std::ios::binary | std::ios::ate);
+	if (!fileIn)
+	{
+		return false;
+	}
+	const std::streamsize size = fileIn.tellg();
+	fileIn.seekg(0, std::ios::beg);
+	out.resize(static_cast<size_t>(size));
+	return size == 0 || static_cast<bool>(fileIn.read(reinterpret_cast<char*>(out.data()), size));
+}
+
+//Ask the OS to drop a file's cached pages so the next read comes from disk
+static bool EvictFromPageCache(const std::string& path)
+{
+#ifdef _WIN32
+	(void)path;
+	return false;
+#else
+	const int fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+	fdatasync(fileDescriptor);
+	const bool evicted = posix_fadvise(fileDescriptor, 0, 0, POSIX_FADV_DONTNEED) == 0;
+	close(fileDescriptor);
+	return evicted;
+#endif
+}
+
+static bool WriteWholeFile(const std::string& path, const std::vector<uint8_t>& data)
+{
+	std::ofstream fileOut(path, std::ios::binary);
+	return fileOut.write(reinterpret_cast<const char*>(data.data()), data.size()) && fileOut.flush();
+}
+
+static bool CompileLevel(const std::string& levelPath, const std::string& itemPath, std::vector<uint8_t>& out)
+{
+	std::vector<uint8_t> levelText, itemText;
+	LevelData level;
+	if (!ReadWholeFile(levelPath, levelText) || !ReadWholeFile(itemPath, itemText) ||
+		!level.ParseText(std::string(levelText.begin(), levelText.end()), std::string(itemText.begin(), itemText.end())))
+	{
+		return false;
+	}
+	level.Write(out);
+	return true;
+}
+
+static int Pack(const std::string& archivePath, const std::string& root, bool allowCompression)
+{
+	AssetPacker packer;
+	size_t totalSize = 0;
+	const std::vector<std::string> assets = FindAssets(root);
+
+	for (const std::string& asset : assets)
+	{
+		std::vector<uint8_t> data;
+		if (!ReadWholeFile((fs::path(root) / asset).string(), data))
+		{
+			fprintf(stderr, "Failed to read %s\n", asset.c_str());
+			return 1;
+		}
+		totalSize += data.size();
+		packer.AddFile(asset, std::move(data), allowCompression && IsCompressible(asset));
+	}
+
+	//Compile every LevelN.txt + LevelN_Items.txt pair that has no compiled level yet
+	const std::string itemSuffix = "_Items.txt";
+	for (const std::string& asset : assets)
+	{
+		if (asset.size() <= itemSuffix.size() || asset.compare(asset.size() - itemSuffix.size(), itemSuffix.size(), itemSuffix) != 0)
+		{
+			continue;
+		}
+
+		const std::string stem = asset.substr(0, asset.size() - itemSuffix.size());
+		if (!std::binary_search(assets.begin(), assets.end(), stem + ".txt") || std::binary_search(assets.begin(), assets.end(), stem + ".lvl"))
+		{
+			continue;
+		}
+
+		std::vector<uint8_t> data;
+		if (!CompileLevel((fs::path(root) / (stem + ".txt")).string(), (fs::path(root) / asset).string(), data))
+		{
+			fprintf(stderr, "Failed to compile %s\n", (stem + ".txt").c_str());
+			return 1;
+		}
+		packer.AddFile(stem + ".lvl", std::move(data), false);
+	}
+
+	if (!packer.Write(archivePath))
+	{
+		fprintf(stderr, "Failed to write %s\n", archivePath.c_str());
+		return 1;
+	}
+
+	printf("Packed %zu files (%zu bytes) into %s (%ju bytes)\n",
+		packer.GetEntryCount(), totalSize, archivePath.c_str(), static_cast<uintmax_t>(fs::file_size(archivePath)));
+	return 0;
+}
+
+static int List(const std::string& archivePath)
+{
+	AssetArchive archive;
+	if (!archive.Open(archivePath))
+	{
+		fprintf(stderr, "Failed to open %s\n", archivePath.c_str());
+		return 1;
+	}
+
+	for (size_t i = 0; i < archive.GetEntryCount(); i++)
+	{
+		const AssetArchive::Entry& entry = archive.GetEntry(i);
+		printf("%016llx %10llu %10llu %s %s\n",
+			static_cast<unsigned long long>(entry.hash),
+			static_cast<unsigned long long>(entry.size),
+			static_cast<unsigned long long>(entry.storedSize),
+			(entry.flags & AssetArchive::Compressed) ? "lz4 " : "map ",
+			archive.GetName(entry).c_str());
+	}
+	return 0;
+}
+
+//Same work the game does at startup: open every asset and touch all of its bytes
+static double TimeArchiveStartup(const std::string& archivePath, const std::vector<std::string>& assets, uint64_t& checksum)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	AssetArchive archive;
+	archive.Open(archivePath);
+
+	std::vector<uint8_t> buffer;
+	for (const std::string& asset : assets)
+	{
+		const AssetArchive::Entry* pEntry = archive.Find(asset);
+		if (pEntry == nullptr)
+		{
+			continue;
+		}
+
+		const uint8_t* pData = archive.GetMappedData(*pEntry);
+		if (pData == nullptr)
+		{
+			archive.Read(*pEntry, buffer);
+			pData = buffer.data();
+		}
+		for (uint64_t i = 0; i < pEntry->size; i++)
+		{
+			checksum += pData[i];
+		}
+	}
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double TimeLooseStartup(const std::string& root, const std::vector<std::string>& assets, uint64_t& checksum)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<uint8_t> buffer;
+	for (const std::string& asset : assets)
+	{
+		ReadWholeFile((fs::path(root) / asset).string(), buffer);
+		for (const uint8_t b : buffer)
+		{
+			checksum += b;
+		}
+	}
+
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void PrintTimes(const char* label, std::vector<double> times)
+{
+	std::sort(times.begin(), times.end());
+	printf("%-14s min %8.3f ms  median %8.3f ms  max %8.3f ms\n", label, times.front(), times[times.size() / 2], times.back());
+}
+
+static int Bench(const std::string& archivePath, const std::string& root, int runs)
+{
+	const std::vector<std::string> assets = FindAssets(root);
+
+	//Drop caches for everything either path will read
+	auto evictAll = [&]()
+	{
+		bool evicted = EvictFromPageCache(archivePath);
+		for (const std::string& asset : assets)
+		{
+			evicted = EvictFromPageCache((fs::path(root) / asset).string()) && evicted;
+		}
+		return evicted;
+	};
+
+	std::vector<double> coldArchive, coldLoose, warmArchive, warmLoose;
+	uint64_t checksum = 0;
+	bool coldSupported = true;
+
+	for (int run = 0; run < runs; run++)
+	{
+		coldSupported = evictAll() && coldSupported;
+		coldArchive.push_back(TimeArchiveStartup(archivePath, assets, checksum));
+		coldSupported = evictAll() && coldSupported;
+		coldLoose.push_back(TimeLooseStartup(root, assets, checksum));
+
+		warmArchive.push_back(TimeArchiveStartup(archivePath, assets, checksum));
+		warmLoose.push_back(TimeLooseStartup(root, assets, checksum));
+	}
+
+	printf("%zu assets, %d runs (checksum %llu)\n", assets.size(), runs, static_cast<unsigned long long>(checksum));
+	if (coldSupported)
+	{
+		PrintTimes("cold archive", coldArchive);
+		PrintTimes("cold loose", coldLoose);
+	}
+	else
+	{
+		printf("Page cache eviction unavailable, cold results skipped\n");
+	}
+	PrintTimes("warm archive", warmArchive);
+	PrintTimes("warm loose", warmLoose);
+	return 0;
+}
+
+static int CompileLevelCommand(const std::string& levelPath, const std::string& itemPath, const std::string& outputPath)
+{
+	std::vector<uint8_t> data;
+	if (!CompileLevel(levelPath, itemPath, data))
+	{
+		fprintf(stderr, "Failed to compile %s\n", levelPath.c_str());
+		return 1;
+	}
+	if (!WriteWholeFile(outputPath, data))
+	{
+		fprintf(stderr, "Failed to write %s\n", outputPath.c_str());
+		return 1;
+	}
+	printf("Compiled %s (%zu bytes)\n", outputPath.c_str(), data.size());
+	return 0;
+}
+
+//Writes a generated level's text grids, and its compiled form when given a path for it
+static int GenerateLevelCommand(const LevelGenerator::Settings& settings, const std::string& levelPath, const std::string& itemPath, const std::string& binaryPath)
+{
+	std::string levelText, itemText;
+	LevelGenerator::Stats stats;
+	if (!LevelGenerator::Generate(settings, levelText, itemText, &stats))
+	{
+		fprintf(stderr, "Cannot generate a %ux%u level, at most 65535 cells a side and 2^28 in all\n", settings.width, settings.depth);
+		return 1;
+	}
+
+	if (!WriteWholeFile(levelPath, std::vector<uint8_t>(levelText.begin(), levelText.end())) ||
+		!WriteWholeFile(itemPath, std::vector<uint8_t>(itemText.begin(), itemText.end())))
+	{
+		fprintf(stderr, "Failed to write %s\n", levelPath.c_str());
+		return 1;
+	}
+
+	std::vector<uint8_t> binary;
+	if (!binaryPath.empty())
+	{
+		LevelData level;
+		level.ParseText(levelText, itemText);
+		level.Write(binary);
+		if (!WriteWholeFile(binaryPath, binary))
+		{
+			fprintf(stderr, "Failed to write %s\n", binaryPath.c_str());
+			return 1;
+		}
+	}
+
+	printf("%ux%u level, seed %u, %s heights up to %d\n", settings.width, settings.depth, settings.seed, LevelGenerator::GetName(settings.heights), settings.maxHeight);
+	printf("%zu tiles, %zu bridge pieces, %zu collectables\n", stats.tileCount, stats.bridgeCount, stats.collectableCount);
+	printf("text   %10zu bytes\n", levelText.size() + itemText.size());
+	if (!binaryPath.empty())
+	{
+		printf("binary %10zu bytes\n", binary.size());
+	}
+	return 0;
+}
+
+static uint64_t SumTiles(const LevelData& level)
+{
+	uint64_t sum = 0;
+	for (size_t i = 0; i < level.GetTileCount(); i++)
+	{
+		const LevelData::Tile& tile = level.GetTiles()[i];
+		sum += tile.x + tile.z + tile.height;
+	}
+	return sum + level.GetMarkerCount();
+}
+
+static int LevelBench(uint32_t size, int runs)
+{
+	const fs::path directory = fs::temp_directory_path() / "LevelBench";
+	fs::create_directories(directory);
+	const std::string levelPath = (directory / "Level.txt").string();
+	const std::string itemPath = (directory / "Level_Items.txt").string();
+	const std::string binaryPath = (directory / "Level.lvl").string();
+
+	std::string levelText, itemText;
+	LevelGenerator::GenerateText(size, 1234, levelText, itemText);
+	std::vector<uint8_t> binary;
+	if (!WriteWholeFile(levelPath, std::vector<uint8_t>(levelText.begin(), levelText.end())) ||
+		!WriteWholeFile(itemPath, std::vector<uint8_t>(itemText.begin(), itemText.end())) ||
+		!CompileLevel(levelPath, itemPath, binary) || !WriteWholeFile(binaryPath, binary))
+	{
+		fprintf(stderr, "Failed to write levels to %s\n", directory.string().c_str());
+		return 1;
+	}
+
+	std::vector<double> textTimes, binaryTimes;
+	uint64_t textSum = 0, binarySum = 0;
+	size_t tileCount = 0;
+
+	for (int run = 0; run < runs; run++)
+	{
+		//Text: read both grids and parse them, as InitialiseLevel does without a compiled level
+		auto start = std::chrono::steady_clock::now();
+		{
+			std::vector<uint8_t> levelData, itemData;
+			ReadWholeFile(levelPath, levelData);
+			ReadWholeFile(itemPath, itemData);
+			LevelData level;
+			level.ParseText(std::string(levelData.begin(), levelData.end()), std::string(itemData.begin(), itemData.end()));
+			textSum = SumTiles(level);
+		}
+		textTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+		//Binary: map the file and walk the populated tiles in place
+		start = std::chrono::steady_clock::now();
+		{
+			MappedFile file(binaryPath);
+			LevelData level;
+			level.LoadView(file.GetData(), file.GetSize());
+			binarySum = SumTiles(level);
+			tileCount = level.GetTileCount();
+		}
+		binaryTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	printf("%ux%u level, %zu populated tiles, %d runs\n", size, size, tileCount, runs);
+	printf("text   %10zu bytes\n", levelText.size() + itemText.size());
+	printf("binary %10zu bytes\n", binary.size());
+	PrintTimes("text load", textTimes);
+	PrintTimes("binary load", binaryTimes);
+
+	fs::remove_all(directory);
+	if (textSum != binarySum)
+	{
+		fprintf(stderr, "Text and binary levels differ\n");
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	const std::string command = argc > 1 ? argv[1] : "";
+
+	if (command == "pack" && (argc == 4 || (argc == 5 && std::string(argv[4]) == "--no-compress")))
+	{
+		return Pack(argv[2], argv[3], argc == 4);
+	}
+	if (command == "list" && argc == 3)
+	{
+		return List(argv[2]);
+	}
+	if (command == "bench" && (argc == 4 || argc == 5))
+	{
+		return Bench(argv[2], argv[3], argc == 5 ? std::max(1, atoi(argv[4])) : 10);
+	}
+	if (command == "level-compile" && argc == 5)
+	{
+		return CompileLevelCommand(argv[2], argv[3], argv[4]);
+	}
+	//Options follow the two grids, any left out keep the defaults in LevelGenerator::Settings
+	if (command == "level-generate" && argc >= 4)
+	{
+		LevelGenerator::Settings settings;
+		std::string binaryPath;
+		bool valid = true;
+		for (int i = 4; i < argc && valid; i++)
+		{
+			const std::string option = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (option == "-lvl" && hasValue)
+			{
+				binaryPath = argv[++i];
+			}
+			else if (option == "-size" && i + 2 < argc)
+			{
+				settings.width = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+				settings.depth = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+			}
+			else if (option == "-seed" && hasValue)
+			{
+				settings.seed = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+			}
+			else if (option == "-fill" && hasValue)
+			{
+				settings.fill = static_cast<float>(atof(argv[++i]));
+			}
+			else if (option == "-heights" && hasValue)
+			{
+				const std::string name = argv[++i];
+				valid = false;
+				for (int heights = 0; heights < LevelGenerator::HeightDistributionCount; heights++)
+				{
+					if (name == LevelGenerator::GetName(LevelGenerator::HeightDistribution(heights)))
+					{
+						settings.heights = LevelGenerator::HeightDistribution(heights);
+						valid = true;
+					}
+				}
+			}
+			else if (option == "-max-height" && hasValue)
+			{
+				settings.maxHeight = std::max(0, atoi(argv[++i]));
+			}
+			else if (option == "-feature" && hasValue)
+			{
+				settings.featureSize = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+			}
+			else if (option == "-bridges" && hasValue)
+			{
+				settings.bridgeDensity = static_cast<float>(atof(argv[++i]));
+			}
+			else if (option == "-collectables" && hasValue)
+			{
+				settings.collectableCount = static_cast<uint32_t>(std::max(0, atoi(argv[++i])));
+			}
+			else
+			{
+				valid = false;
+			}
+		}
+		if (valid)
+		{
+			return GenerateLevelCommand(settings, argv[2], argv[3], binaryPath);
+		}
+	}
+	if (command == "level-bench" && argc <= 4)
+	{
+		return LevelBench(argc > 2 ? static_cast<uint32_t>(std::max(1, std::min(65535, atoi(argv[2])))) : 4096, argc > 3 ? std::max(1, atoi(argv[3])) : 5);
+	}
+
+	fprintf(stderr,
+		"usage: AssetTool pack <archive.pak> <asset root> [--no-compress]\n"
+		"       AssetTool list <archive.pak>\n"
+		"       AssetTool bench <archive.pak> <asset root> [runs]\n"
+		"       AssetTool level-compile <LevelN.txt> <LevelN_Items.txt> <LevelN.lvl>\n"
+		"       AssetTool level-generate <LevelN.txt> <LevelN_Items.txt> [-lvl LevelN.lvl] [-size width depth] [-seed N] [-fill 0-1]\n"
+		"                                [-heights flat|uniform|terrain] [-max-height N] [-feature cells] [-bridges 0-1] [-collectables N]\n"
+		"       AssetTool level-bench [size] [runs]\n");
+	return 1;
+}
@@ -0,0 +1,1371 @@
+//Command line benchmarks for engine code that does not need a window
+//
+//	Benchmark jobs [objects] [frames] [max threads]
+//	Benchmark level-build [size] [runs] [max threads]
+//	Benchmark allocations [size] [frames]
+//	Benchmark counters [size] [frames] [csv|json]
+//	Benchmark suite [runs] [model folder] > results.json
+//	Benchmark compare base.json head.json [threshold %] [counter threshold %]
+//	Benchmark replay recording.inp [trajectory.csv] [game folder]
+//	Benchmark check recording.inp [game folder]
+//	Benchmark rehash recording.inp output.inp [game folder]
+//	Benchmark replay-suite recording.inp... [-runs N] [-dt seconds] [-game folder] > replays.json
+//	Benchmark batch [instances] [frames] [level] [max threads] [game folder]
+//
+//Builds with the Benchmark project on Windows, or on Linux with the DirectXMath headers (and the sal.h stub that comes with DirectX-Headers) on the include path
+//	g++ -std=c++17 -O2 -pthread -I../../3D-Platformer -I<DirectXMath>/Inc -I<DirectX-Headers>/include/wsl/stubs Benchmark.cpp ../../3D-Platformer/AllocationTracker.cpp ../../3D-Platformer/AssetArchive.cpp ../../3D-Platformer/BlockCache.cpp ../../3D-Platformer/ChunkStreamer.cpp ../../3D-Platformer/DirectoryMount.cpp ../../3D-Platformer/FilePath.cpp ../../3D-Platformer/FrameStats.cpp ../../3D-Platformer/InputRecording.cpp ../../3D-Platformer/JobSystem.cpp ../../3D-Platformer/LevelChunk.cpp ../../3D-Platformer/LevelData.cpp ../../3D-Platformer/LevelGenerator.cpp ../../3D-Platformer/LevelState.cpp ../../3D-Platformer/Lz4.cpp ../../3D-Platformer/MappedFile.cpp ../../3D-Platformer/MemoryTracker.cpp ../../3D-Platformer/NullRenderer.cpp ../../3D-Platformer/ObjModel.cpp ../../3D-Platformer/PerfCounters.cpp ../../3D-Platformer/PlayerPhysics.cpp ../../3D-Platformer/Profiler.cpp ../../3D-Platformer/Registry.cpp ../../3D-Platformer/RenderQueue.cpp ../../3D-Platformer/Simulation.cpp ../../3D-Platformer/SimulationBatch.cpp ../../3D-Platformer/Systems.cpp ../../3D-Platformer/TileRecord.cpp ../../3D-Platformer/TransformBatch.cpp ../../3D-Platformer/VirtualFile.cpp ../../3D-Platformer/VirtualFileSystem.cpp -o Benchmark
+
+#include "AllocationTracker.h"
+#include "ChunkStreamer.h"
+#include "DirectoryMount.h"
+#include "InputRecording.h"
+#include "JobSystem.h"
+#include "LevelGenerator.h"
+#include "MemoryTracker.h"
+#include "NullRenderer.h"
+#include "ObjModel.h"
+#include "PerfCounters.h"
+#include "Registry.h"
+#include "RenderQueue.h"
+#include "Simulation.h"
+#include "SimulationBatch.h"
+#include "Systems.h"
+#include "VirtualFileSystem.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cwchar>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static double Median(std::vector<double> times)
+{
+	std::sort(times.begin(), times.end());
+	return times[times.size() / 2];
+}
+
+//The time a fraction of the way through already sorted times, 0.5 picks the same one as Median
+static double Percentile(const std::vector<double>& sortedTimes, double fraction)
+{
+	return sortedTimes[std::min(sortedTimes.size() - 1, static_cast<size_t>(fraction * double(sortedTimes.size())))];
+}
+
+//1, 2, 4 ... up to maxThreads
+static std::vector<size_t> GetThreadCounts(size_t maxThreads)
+{
+	std::vector<size_t> threadCounts;
+	for (size_t threads = 1; threads < maxThreads; threads *= 2)
+	{
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+	return threadCounts;
+}
+
+//Objects scattered over a large level, each one spinning like a collectable, entity ids match their index in every array
+static void BuildSyntheticLevel(Registry& registry, size_t objectCount)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-256.0f, 256.0f);
+	std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+	std::uniform_real_distribution<float> scale(0.25f, 2.0f);
+
+	for (size_t i = 0; i < objectCount; i++)
+	{
+		const Entity entity = registry.Create();
+
+		TransformComponent transform;
+		transform.position = { position(random), position(random) * 0.05f, position(random) };
+		transform.rotation = { angle(random), angle(random), angle(random) };
+		const float uniformScale = scale(random);
+		transform.scale = { uniformScale, uniformScale, uniformScale };
+		registry.transforms.Add(entity, transform);
+
+		registry.worlds.Add(entity, WorldComponent{});
+		registry.bounds.Add(entity, BoundsComponent{ { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f }, {}, {} });
+
+		AnimatorComponent animator = {};
+		animator.spinSpeed = angle(random);
+		registry.animators.Add(entity, animator);
+	}
+}
+
+//Sum of every world box, used to check each thread count produced the same level
+static double SumBounds(const Registry& registry)
+{
+	double sum = 0.0;
+	for (size_t i = 0; i < registry.bounds.GetSize(); i++)
+	{
+		const BoundsComponent& bounds = registry.bounds.GetAt(i);
+		sum += bounds.worldMin.x + bounds.worldMin.y + bounds.worldMin.z + bounds.worldMax.x + bounds.worldMax.y + bounds.worldMax.z;
+	}
+	return sum;
+}
+
+//Times two frame stages at 1, 2, 4 ... threads up to maxThreads
+//	per object: spin each object and rebuild its matrix and box one at a time in a parallel for
+//	batch:      mark every object dirty and run TransformSystem::Update, which splits the SIMD batch into jobs
+static int JobsBench(size_t objectCount, int frames, size_t maxThreads)
+{
+	const std::vector<size_t> threadCounts = GetThreadCounts(maxThreads);
+
+	printf("%zu objects, %d frames, %u hardware threads\n", objectCount, frames, std::thread::hardware_concurrency());
+	printf("%-8s %14s %9s %14s %9s %10s\n", "threads", "per object ms", "speed-up", "batch ms", "speed-up", "steals");
+
+	double baseObjectMilliseconds = 0.0, baseBatchMilliseconds = 0.0;
+	double expectedSum = 0.0;
+	bool mismatch = false;
+	const float dt = 1.0f / 60.0f;
+
+	for (const size_t threads : threadCounts)
+	{
+		Registry registry;
+		BuildSyntheticLevel(registry, objectCount);
+
+		JobSystem::Start(threads);
+		JobSystem::ResetStats();
+
+		std::vector<double> objectTimes, batchTimes;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			JobSystem::ParallelFor(registry.animators.GetSize(), 1024, [&registry, dt](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+				{
+					TransformComponent& transform = registry.transforms.GetAt(i);
+					WorldComponent& world = registry.worlds.GetAt(i);
+					transform.rotation.y += registry.animators.GetAt(i).spinSpeed * dt;
+					TransformSystem::CalculateWorld(transform, world);
+					TransformSystem::CalculateWorldBounds(world, registry.bounds.GetAt(i));
+				}
+			});
+			objectTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+			for (size_t i = 0; i < registry.transforms.GetSize(); i++)
+			{
+				registry.MarkDirty(registry.transforms.GetEntityAt(i));
+			}
+			start = std::chrono::steady_clock::now();
+			TransformSystem::Update(registry);
+			batchTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		}
+
+		const JobSystem::Stats stats = JobSystem::GetStats();
+		JobSystem::Stop();
+
+		const double objectMilliseconds = Median(objectTimes);
+		const double batchMilliseconds = Median(batchTimes);
+		if (threads == 1)
+		{
+			baseObjectMilliseconds = objectMilliseconds;
+			baseBatchMilliseconds = batchMilliseconds;
+			expectedSum = SumBounds(registry);
+		}
+		else if (SumBounds(registry) != expectedSum)
+		{
+			mismatch = true;
+		}
+
+		printf("%-8zu %14.3f %8.2fx %14.3f %8.2fx %10llu\n", threads,
+			objectMilliseconds, baseObjectMilliseconds / objectMilliseconds,
+			batchMilliseconds, baseBatchMilliseconds / batchMilliseconds,
+			static_cast<unsigned long long>(stats.jobsStolen));
+	}
+
+	if (mismatch)
+	{
+		fprintf(stderr, "Thread counts produced different results\n");
+		return 1;
+	}
+	return 0;
+}
+
+//Times the phases of a level build that need no device on a generated level, with every chunk of the level in range
+//Meshes and entities are left out, they need a window to build their GPU resources
+static int LevelBuildBench(uint32_t size, int runs, size_t maxThreads)
+{
+	std::string levelText, itemText;
+	LevelGenerator::GenerateText(size, 1234, levelText, itemText);
+
+	ChunkStreamer::Settings settings;
+	settings.loadRadius = float(size) * 2.0f;
+	settings.unloadRadius = settings.loadRadius;
+	settings.memoryBudget = ~size_t(0);
+
+	printf("%ux%u level, %d runs, %u hardware threads\n", size, size, runs, std::thread::hardware_concurrency());
+	printf("%-8s %10s %10s %9s %8s\n", "threads", "parse ms", "chunks ms", "speed-up", "tiles");
+
+	double baseChunkMilliseconds = 0.0;
+	size_t expectedTiles = 0;
+	bool mismatch = false;
+
+	for (const size_t threads : GetThreadCounts(maxThreads))
+	{
+		JobSystem::Start(threads);
+
+		std::vector<double> parseTimes, chunkTimes;
+		size_t tileCount = 0;
+		for (int run = 0; run < runs; run++)
+		{
+			auto start = std::chrono::steady_clock::now();
+			LevelData levelData;
+			levelData.ParseText(levelText, itemText);
+			parseTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+			start = std::chrono::steady_clock::now();
+			ChunkStreamer streamer(levelData, settings);
+			streamer.LoadAround(float(size) * 0.5f, float(size) * 0.5f);
+			chunkTimes.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+			tileCount = 0;
+			for (const LevelChunk* pChunk : streamer.GetLoadedChunks())
+			{
+				tileCount += pChunk->tiles.size();
+			}
+		}
+
+		JobSystem::Stop();
+
+		const double chunkMilliseconds = Median(chunkTimes);
+		if (threads == 1)
+		{
+			baseChunkMilliseconds = chunkMilliseconds;
+			expectedTiles = tileCount;
+		}
+		else if (tileCount != expectedTiles)
+		{
+			mismatch = true;
+		}
+
+		printf("%-8zu %10.3f %10.3f %8.2fx %8zu\n", threads, Median(parseTimes), chunkMilliseconds, baseChunkMilliseconds / chunkMilliseconds, tileCount);
+	}
+
+	if (mismatch)
+	{
+		fprintf(stderr, "Thread counts produced different levels\n");
+		return 1;
+	}
+	return 0;
+}
+
+//The level systems of a headless frame, on a generated level with 10000 spinning collectables around the player
+//The allocations and counters benchmarks both step it, so they measure the same frame
+class HeadlessFrameLoop
+{
+public:
+	//The player's walks go round once in this many frames
+	static constexpr int lapFrames = 120;
+public:
+	explicit HeadlessFrameLoop(uint32_t size)
+	{
+		std::string levelText, itemText;
+		LevelGenerator::GenerateText(size, 1234, levelText, itemText);
+		levelData.ParseText(levelText, itemText);
+		pStreamer = std::make_unique<ChunkStreamer>(levelData, ChunkStreamer::Settings());
+
+		BuildSyntheticLevel(registry, 10000);
+		for (size_t i = 0; i < registry.transforms.GetSize(); i++)
+		{
+			const Entity entity = registry.transforms.GetEntityAt(i);
+			registry.colliders.Add(entity, ColliderComponent{ OverlapCollider });
+			registry.triggers.Add(entity, TriggerComponent{ CollectTrigger });
+		}
+
+		//Reserved like Game's list, the most overlaps at once can come long after a warm-up
+		overlaps.reserve(256);
+	}
+
+	//Streams around a player at x, z, moves the entities and fires the triggers the player stands in
+	void Step(float x, float z, float dt)
+	{
+		pStreamer->Update(x, z);
+		AnimationSystem::Update(registry, dt);
+		TransformSystem::Update(registry);
+		CollisionSystem::FindOverlaps(registry, { x - 0.5f, 0.0f, z - 0.5f }, { x + 0.5f, 2.0f, z + 0.5f }, OverlapCollider, overlaps);
+		TriggerSystem::Fire(registry, overlaps);
+	}
+
+	ChunkStreamer& GetStreamer() noexcept { return *pStreamer; }
+	const Registry& GetRegistry() const noexcept { return registry; }
+private:
+	LevelData levelData;
+	std::unique_ptr<ChunkStreamer> pStreamer;
+	Registry registry;
+	std::vector<Entity> overlaps;
+};
+
+//Runs the level systems of a frame on a generated level with the player walking in a circle, and fails if a frame allocates once warmed up
+//The warm-up is two laps, so every chunk the walk reaches has been loaded and every reused buffer has grown to its size
+static int AllocationsBench(uint32_t size, int frames)
+{
+	if (!AllocationTracker::IsEnabled())
+	{
+		fprintf(stderr, "Allocation tracking is compiled out\n");
+		return 1;
+	}
+
+	JobSystem::Start();
+	const float centre = float(size) * 0.5f;
+	HeadlessFrameLoop loop(size);
+	ChunkStreamer& streamer = loop.GetStreamer();
+	streamer.LoadAround(centre, centre);
+
+	const int lapFrames = HeadlessFrameLoop::lapFrames;
+	const int warmUpFrames = lapFrames * 2;
+	const float dt = 1.0f / 60.0f;
+	uint64_t warmUpAllocations = 0, steadyAllocations = 0, steadyBytes = 0;
+	int firstAllocatingFrame = -1;
+
+	for (int frame = 0; frame < warmUpFrames + frames; frame++)
+	{
+		//Chunks still being built at the end of the warm-up would allocate as they arrive
+		while (frame == warmUpFrames && streamer.GetPendingCount() > 0)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			streamer.Update(centre + 4.0f, centre);
+		}
+
+		const float angle = 6.2831853f * float(frame % lapFrames) / float(lapFrames);
+		const float x = centre + std::cos(angle) * 4.0f;
+		const float z = centre + std::sin(angle) * 4.0f;
+
+		const AllocationScope allocations;
+		loop.Step(x, z, dt);
+
+		if (frame < warmUpFrames)
+		{
+			warmUpAllocations += allocations.GetAllocations();
+		}
+		else
+		{
+			if (allocations.GetAllocations() > 0 && firstAllocatingFrame < 0)
+			{
+				firstAllocatingFrame = frame - warmUpFrames;
+			}
+			steadyAllocations += allocations.GetAllocations();
+			steadyBytes += allocations.GetBytes();
+		}
+	}
+
+	JobSystem::Stop();
+
+	printf("%ux%u level, %zu entities, %zu chunks loaded\n", size, size, loop.GetRegistry().transforms.GetSize(), streamer.GetLoadedChunks().size());
+	printf("warm-up: %d frames, %llu allocations\n", warmUpFrames, static_cast<unsigned long long>(warmUpAllocations));
+	printf("steady:  %d frames, %llu allocations, %llu bytes\n", frames,
+		static_cast<unsigned long long>(steadyAllocations), static_cast<unsigned long long>(steadyBytes));
+
+	if (steadyAllocations > 0)
+	{
+		fprintf(stderr, "Frame %d after warm-up allocated\n", firstAllocatingFrame);
+		return 1;
+	}
+	return 0;
+}
+
+//The per frame counters of the headless frame loop, written to stdout as CSV rows or one JSON object per line
+static int CountersBench(uint32_t size, int frames, bool json)
+{
+	JobSystem::Start();
+	const float centre = float(size) * 0.5f;
+	HeadlessFrameLoop loop(size);
+
+	const int lapFrames = HeadlessFrameLoop::lapFrames;
+	const float dt = 1.0f / 60.0f;
+
+	if (!json)
+	{
+		PerfCounters::WriteCsvHeader(std::cout);
+	}
+
+	for (int frame = 0; frame < frames; frame++)
+	{
+		//Walks out of the middle chunk and back, so chunks load during the run
+		const float angle = 6.2831853f * float(frame % lapFrames) / float(lapFrames);
+		const float radius = float(size) * 0.25f * std::sin(3.14159265f * float(frame) / float(frames));
+		const float x = centre + std::cos(angle) * radius;
+		const float z = centre + std::sin(angle) * radius;
+
+		const auto start = std::chrono::steady_clock::now();
+		const AllocationScope allocations;
+		loop.Step(x, z, dt);
+		const double frameMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		PerfCounters::Add(PerfCounters::AllocationCounter, allocations.GetAllocations());
+		PerfCounters::Set(PerfCounters::FrameMillisecondsGauge, frameMilliseconds);
+		PerfCounters::Set(PerfCounters::SimMillisecondsGauge, frameMilliseconds);
+		PerfCounters::Set(PerfCounters::EntityGauge, double(loop.GetRegistry().transforms.GetSize()));
+		PerfCounters::Set(PerfCounters::LoadedChunkGauge, double(loop.GetStreamer().GetLoadedChunks().size()));
+		PerfCounters::Set(PerfCounters::CpuBytesGauge, double(MemoryTracker::GetTotalBytes(false)));
+		PerfCounters::EndFrame();
+
+		if (json)
+		{
+			PerfCounters::WriteJson(std::cout, uint64_t(frame));
+		}
+		else
+		{
+			PerfCounters::WriteCsvRow(std::cout, uint64_t(frame));
+		}
+	}
+
+	JobSystem::Stop();
+	return 0;
+}
+
+//One case of the suite, times are per run of the whole case
+struct SuiteResult
+{
+	std::string name;
+	size_t items;
+	double medianMilliseconds;
+	double minMilliseconds;
+};
+
+//Keeps results the compiler could otherwise throw away along with the work that made them
+static volatile uint64_t suiteSink = 0;
+
+//Runs a case the given number of times after one untimed run, prepare is called before every run and is not timed
+template<typename Prepare, typename Run>
+static void RunSuiteCase(std::vector<SuiteResult>& results, const std::string& name, size_t items, int runs, Prepare prepare, Run run)
+{
+	prepare();
+	run();
+
+	std::vector<double> times;
+	for (int i = 0; i < runs; i++)
+	{
+		prepare();
+		const auto start = std::chrono::steady_clock::now();
+		run();
+		times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+	}
+
+	results.push_back({ name, items, Median(times), *std::min_element(times.begin(), times.end()) });
+	fprintf(stderr, "%-32s %10.3f ms\n", name.c_str(), results.back().medianMilliseconds);
+}
+
+//A flat grid of quads with texture coordinates and normals, like an exported model, with about faceCount faces
+static std::wstring GenerateObjText(size_t faceCount)
+{
+	const size_t side = std::max<size_t>(1, static_cast<size_t>(std::sqrt(double(faceCount))));
+	std::wostringstream text;
+	text << L"# Generated grid\nmtllib grid.mtl\n";
+	for (size_t z = 0; z <= side; z++)
+	{
+		for (size_t x = 0; x <= side; x++)
+		{
+			text << L"v " << float(x) << L" 0 " << float(z) << L"\n";
+			text << L"vt " << float(x) / float(side) << L" " << float(z) / float(side) << L"\n";
+		}
+	}
+	text << L"vn 0 1 0\nusemtl grid\n";
+	for (size_t z = 0; z < side; z++)
+	{
+		for (size_t x = 0; x < side; x++)
+		{
+			const size_t corners[4] = { z * (side + 1) + x + 1, z * (side + 1) + x + 2, (z + 1) * (side + 1) + x + 2, (z + 1) * (side + 1) + x + 1 };
+			text << L"f";
+			for (const size_t corner : corners)
+			{
+				text << L" " << corner << L"/" << corner << L"/1";
+			}
+			text << L"\n";
+		}
+	}
+	return text.str();
+}
+
+//The .obj files in a folder sorted by name, so the suite lists them in the same order everywhere
+static std::vector<std::filesystem::path> FindModels(const std::string& folder)
+{
+	std::vector<std::filesystem::path> models;
+	std::error_code error;
+	for (const auto& item : std::filesystem::directory_iterator(folder, error))
+	{
+		if (item.path().extension() == ".obj")
+		{
+			models.push_back(item.path());
+		}
+	}
+	std::sort(models.begin(), models.end());
+	return models;
+}
+
+static std::wstring ReadWideText(const std::filesystem::path& path)
+{
+	std::ifstream fileIn(path, std::ios::binary);
+	const std::string text((std::istreambuf_iterator<char>(fileIn)), std::istreambuf_iterator<char>());
+	return std::wstring(text.begin(), text.end());
+}
+
+//Boxes scattered around the origin the size of level tiles, with the player's box among them
+static void BuildBoxes(size_t count, std::vector<Float3>& boxMin, std::vector<Float3>& boxMax)
+{
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-16.0f, 16.0f);
+	boxMin.resize(count);
+	boxMax.resize(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		boxMin[i] = { position(random), position(random) * 0.25f, position(random) };
+		boxMax[i] = { boxMin[i].x + 1.0f, boxMin[i].y + 1.0f, boxMin[i].z + 1.0f };
+	}
+}
+
+//The engine's hot paths at fixed sizes with fixed seeds, written as JSON with one case per line so two runs can be compared
+//Jobs run on one thread, so results are comparable between machines with different core counts
+static int SuiteBench(int runs, const std::string& modelFolder)
+{
+	JobSystem::Start(1);
+	std::vector<SuiteResult> results;
+
+	const Float3 playerMin = { -0.5f, 0.0f, -0.5f };
+	const Float3 playerMax = { 0.5f, 2.0f, 0.5f };
+	for (const size_t count : { size_t(1024), size_t(65536) })
+	{
+		std::vector<Float3> boxMin, boxMax;
+		BuildBoxes(count, boxMin, boxMax);
+
+		RunSuiteCase(results, "collision/check/" + std::to_string(count), count, runs, [] {}, [&]
+		{
+			uint64_t hits = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				hits += CollisionSystem::CheckOverlap(playerMin, playerMax, boxMin[i], boxMax[i]) ? 1 : 0;
+			}
+			suiteSink = suiteSink + hits;
+		});
+
+		//Every box moved onto the player, so each one is resolved
+		RunSuiteCase(results, "collision/response/" + std::to_string(count), count, runs, [] {}, [&]
+		{
+			float pushed = 0.0f;
+			for (size_t i = 0; i < count; i++)
+			{
+				const Float3 offset = { boxMin[i].x * 0.05f, boxMin[i].y * 0.05f - 0.5f, boxMin[i].z * 0.05f };
+				const Float3 bMin = { offset.x - 0.5f, offset.y - 0.5f, offset.z - 0.5f };
+				const Float3 bMax = { offset.x + 0.5f, offset.y + 0.5f, offset.z + 0.5f };
+				const CollisionSystem::Response response = CollisionSystem::CalculateResponse(playerMin, playerMax, bMin, bMax, { 0.0f, 1.0f, 0.0f }, offset);
+				pushed += response.push.x + response.push.y + response.push.z;
+			}
+			suiteSink = suiteSink + static_cast<uint64_t>(pushed != 0.0f);
+		});
+	}
+
+	for (const size_t count : { size_t(1024), size_t(65536) })
+	{
+		Registry registry;
+		BuildSyntheticLevel(registry, count);
+
+		RunSuiteCase(results, "aabb/world-bounds/" + std::to_string(count), count, runs, [] {}, [&]
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				TransformSystem::CalculateWorldBounds(registry.worlds.GetAt(i), registry.bounds.GetAt(i));
+			}
+		});
+
+		RunSuiteCase(results, "transform/rebuild/" + std::to_string(count), count, runs, [&]
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				registry.MarkDirty(registry.transforms.GetEntityAt(i));
+			}
+		}, [&]
+		{
+			TransformSystem::Update(registry);
+		});
+	}
+
+	for (const size_t count : { size_t(1024), size_t(65536) })
+	{
+		//Draws of 64 meshes in random order, the pointers are only compared so they need not point at real meshes
+		static const char meshes[64] = {};
+		std::mt19937 random(1234);
+		std::vector<DrawCommand> unsorted(count), drawList;
+		for (DrawCommand& command : unsorted)
+		{
+			command.pMesh = reinterpret_cast<const GameObject*>(&meshes[random() % 64]);
+		}
+
+		RunSuiteCase(results, "render/sort/" + std::to_string(count), count, runs, [&] { drawList = unsorted; }, [&]
+		{
+			RenderQueue::Sort(drawList);
+		});
+	}
+
+	for (const uint32_t size : { 256u, 1024u })
+	{
+		std::string levelText, itemText;
+		LevelGenerator::GenerateText(size, 1234, levelText, itemText);
+		LevelData levelData;
+		std::vector<uint8_t> binary;
+
+		RunSuiteCase(results, "level/parse-text/" + std::to_string(size), size_t(size) * size, runs, [&] { levelData.Clear(); }, [&]
+		{
+			levelData.ParseText(levelText, itemText);
+		});
+
+		levelData.Write(binary);
+		RunSuiteCase(results, "level/load-binary/" + std::to_string(size), size_t(size) * size, runs, [&] { levelData.Clear(); }, [&]
+		{
+			levelData.LoadView(binary.data(), binary.size());
+		});
+	}
+
+	for (const size_t faces : { size_t(256), size_t(1024), size_t(4096) })
+	{
+		const std::wstring objText = GenerateObjText(faces);
+		RunSuiteCase(results, "obj/parse-generated/" + std::to_string(faces), faces, runs, [] {}, [&]
+		{
+			ObjModel model;
+			model.ParseObj(objText);
+			suiteSink = suiteSink + model.indices.size();
+		});
+	}
+
+	for (const std::filesystem::path& path : FindModels(modelFolder))
+	{
+		const std::wstring objText = ReadWideText(path);
+		ObjModel counted;
+		counted.ParseObj(objText);
+		RunSuiteCase(results, "obj/parse/" + path.stem().string(), size_t(counted.totalFaces), runs, [] {}, [&]
+		{
+			ObjModel model;
+			model.ParseObj(objText);
+			suiteSink = suiteSink + model.indices.size();
+		});
+	}
+
+	JobSystem::Stop();
+
+	printf("{\n\"version\": 1,\n\"runs\": %d,\n\"benchmarks\": [\n", runs);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const SuiteResult& result = results[i];
+		printf("{\"name\":\"%s\",\"items\":%zu,\"median_ms\":%.6f,\"min_ms\":%.6f,\"ns_per_item\":%.3f}%s\n", result.name.c_str(), result.items,
+			result.medianMilliseconds, result.minMilliseconds, result.medianMilliseconds * 1e6 / double((std::max)(result.items, size_t(1))),
+			i + 1 < results.size() ? "," : "");
+	}
+	printf("]\n}\n");
+	return 0;
+}
+
+//Median times of each case in a suite output, read back from the one case per line layout SuiteBench writes
+static std::vector<SuiteResult> ReadSuiteResults(const std::string& path)
+{
+	std::vector<SuiteResult> results;
+	std::ifstream fileIn(path);
+	std::string line;
+	while (std::getline(fileIn, line))
+	{
+		char name[128];
+		SuiteResult result;
+		if (sscanf(line.c_str(), "{\"name\":\"%127[^\"]\",\"items\":%zu,\"median_ms\":%lf,\"min_ms\":%lf", name, &result.items,
+			&result.medianMilliseconds, &result.minMilliseconds) == 4)
+		{
+			result.name = name;
+			results.push_back(result);
+		}
+	}
+	return results;
+}
+
+//Total of one counter over a replay, read back from the counters the replay suite writes after its cases
+struct CounterResult
+{
+	std::string name;
+	uint64_t total;
+};
+
+static std::vector<CounterResult> ReadCounterResults(const std::string& path)
+{
+	std::vector<CounterResult> results;
+	std::ifstream fileIn(path);
+	std::string line;
+	while (std::getline(fileIn, line))
+	{
+		char name[128];
+		unsigned long long total;
+		if (sscanf(line.c_str(), "{\"name\":\"%127[^\"]\",\"total\":%llu", name, &total) == 2)
+		{
+			results.push_back({ name, total });
+		}
+	}
+	return results;
+}
+
+//Fails if any case in head is slower than in base by more than the threshold, cases only in one of them are listed and ignored
+//Replay suites also fail if a counter grew by more than its own threshold, counters that did not change are not listed
+static int CompareSuites(const std::string& basePath, const std::string& headPath, double thresholdPercent, double counterThresholdPercent)
+{
+	const std::vector<SuiteResult> base = ReadSuiteResults(basePath);
+	const std::vector<SuiteResult> head = ReadSuiteResults(headPath);
+	if (base.empty() || head.empty())
+	{
+		fprintf(stderr, "No results in %s\n", base.empty() ? basePath.c_str() : headPath.c_str());
+		return 1;
+	}
+
+	printf("%-32s %12s %12s %9s\n", "case", "base ms", "head ms", "change");
+	int regressions = 0;
+	for (const SuiteResult& headResult : head)
+	{
+		const auto baseResult = std::find_if(base.begin(), base.end(), [&headResult](const SuiteResult& result) { return result.name == headResult.name; });
+		if (baseResult == base.end())
+		{
+			printf("%-32s %12s %12.3f %9s\n", headResult.name.c_str(), "-", headResult.medianMilliseconds, "new");
+			continue;
+		}
+
+		const double change = (headResult.medianMilliseconds / baseResult->medianMilliseconds - 1.0) * 100.0;
+		const bool regressed = change > thresholdPercent;
+		regressions += regressed ? 1 : 0;
+		printf("%-32s %12.3f %12.3f %+8.1f%%%s\n", headResult.name.c_str(), baseResult->medianMilliseconds, headResult.medianMilliseconds, change, regressed ? "  SLOWER" : "");
+	}
+	for (const SuiteResult& baseResult : base)
+	{
+		if (std::none_of(head.begin(), head.end(), [&baseResult](const SuiteResult& result) { return result.name == baseResult.name; }))
+		{
+			printf("%-32s %12.3f %12s %9s\n", baseResult.name.c_str(), baseResult.medianMilliseconds, "-", "removed");
+		}
+	}
+
+	const std::vector<CounterResult> baseCounters = ReadCounterResults(basePath);
+	const std::vector<CounterResult> headCounters = ReadCounterResults(headPath);
+	int counterChanges = 0, counterRegressions = 0;
+	for (const CounterResult& headCounter : headCounters)
+	{
+		const auto baseCounter = std::find_if(baseCounters.begin(), baseCounters.end(), [&headCounter](const CounterResult& counter) { return counter.name == headCounter.name; });
+		if (baseCounter == baseCounters.end() || baseCounter->total == headCounter.total)
+		{
+			continue;
+		}
+
+		if (counterChanges++ == 0)
+		{
+			printf("\n%-40s %12s %12s %9s\n", "counter", "base", "head", "change");
+		}
+		const double change = baseCounter->total > 0 ? (double(headCounter.total) / double(baseCounter->total) - 1.0) * 100.0 : 100.0;
+		const bool regressed = change > counterThresholdPercent;
+		counterRegressions += regressed ? 1 : 0;
+		printf("%-40s %12llu %12llu %+8.1f%%%s\n", headCounter.name.c_str(), static_cast<unsigned long long>(baseCounter->total),
+			static_cast<unsigned long long>(headCounter.total), change, regressed ? "  MORE" : "");
+	}
+
+	if (regressions > 0 || counterRegressions > 0)
+	{
+		fprintf(stderr, "%d cases more than %.1f%% slower, %d counters more than %.1f%% higher\n", regressions, thresholdPercent, counterRegressions, counterThresholdPercent);
+		return 1;
+	}
+	return 0;
+}
+
+//Mounts the game's folder for the replays, entities of a missing model get an empty box so the replay would not match the game
+static void MountGameFolder(const std::string& gameFolder)
+{
+	JobSystem::Start(1);
+	VirtualFileSystem::Mount("", std::make_unique<DirectoryMount>(gameFolder));
+
+	for (int kind = 0; kind < LevelState::EntityKindCount; kind++)
+	{
+		const wchar_t* modelName = LevelState::GetModelName(LevelState::EntityKind(kind));
+		const std::string modelPath = modelName != nullptr ? "3DObjects/" + std::string(modelName, modelName + wcslen(modelName)) + ".obj" : "";
+		if (modelName != nullptr && !VirtualFileSystem::Exists(modelPath))
+		{
+			fprintf(stderr, "warning: %s is missing, its entities will not collide or trigger\n", modelPath.c_str());
+		}
+	}
+}
+
+//Steps the frames of a recording through the simulation one at a time, swapping levels at each goal like the game does
+class RecordingPlayer
+{
+public:
+	//A fixed frame time replaces the recorded ones, 0 keeps them so the replay matches the session
+	RecordingPlayer(const InputRecording& _recording, float _fixedDt = 0.0f) :
+		recording(_recording),
+		fixedDt(_fixedDt),
+		levelNum(_recording.GetStartLevel())
+	{
+		//Chunks are built as the player reaches them, like the game does while recording
+		settings.synchronous = true;
+		pLevel = LevelState::BuildHeadless(levelNum, settings);
+		simulation.SetLevel(pLevel.get());
+		startState.resize(simulation.GetStateSize());
+		simulation.SaveState(startState.data());
+	}
+
+	//Back to the first frame, the start level is put back from a snapshot instead of being built again if the replay never left it
+	//Its chunks are streamed again from the spawn point, so the run loads and collides with the same chunks as one on a new build
+	void Restart()
+	{
+		nextFrame = 0;
+		if (levelNum == recording.GetStartLevel())
+		{
+			simulation.LoadState(startState.data());
+			pLevel->ResetChunks();
+			return;
+		}
+
+		levelNum = recording.GetStartLevel();
+		pLevel = LevelState::BuildHeadless(levelNum, settings);
+		simulation.SetLevel(pLevel.get());
+	}
+
+	//Steps the next frame, returns false once every frame has been played
+	bool Step(FrameStats& frameStats)
+	{
+		if (nextFrame == recording.GetFrameCount())
+		{
+			return false;
+		}
+
+		input = recording.GetFrame(nextFrame++);
+		if (fixedDt > 0.0f)
+		{
+			input.dt = fixedDt;
+		}
+
+		if (simulation.Step(input, frameStats) && levelNum < LevelState::levelCount)
+		{
+			levelNum++;
+			pLevel = LevelState::BuildHeadless(levelNum, settings);
+			simulation.SetLevel(pLevel.get());
+		}
+		return true;
+	}
+
+	size_t GetFrame() const noexcept { return nextFrame - 1; }
+	const InputFrame& GetInput() const noexcept { return input; }
+	int GetLevelNum() const noexcept { return levelNum; }
+	const LevelState& GetLevel() const noexcept { return *pLevel; }
+	const Simulation& GetSimulation() const noexcept { return simulation; }
+private:
+	const InputRecording& recording;
+	float fixedDt;
+	ChunkStreamer::Settings settings;
+	int levelNum;
+	std::unique_ptr<LevelState> pLevel;
+	Simulation simulation;
+	InputFrame input;
+	size_t nextFrame = 0;
+	std::vector<uint8_t> startState;
+};
+
+//Plays a recording from -record through the simulation on the game's levels, without a window, and writes where the player was after every frame
+//The same recording writes the same trajectory every run, the floats are printed with enough digits to tell any two apart
+static int ReplayBench(const std::string& recordingPath, const std::string& trajectoryPath, const std::string& gameFolder)
+{
+	InputRecording recording;
+	if (!recording.Load(recordingPath))
+	{
+		fprintf(stderr, "Failed to load %s\n", recordingPath.c_str());
+		return 1;
+	}
+	MountGameFolder(gameFolder);
+
+	//No path, or -, writes to stdout
+	FILE* pOut = trajectoryPath.empty() || trajectoryPath == "-" ? stdout : fopen(trajectoryPath.c_str(), "w");
+	if (pOut == nullptr)
+	{
+		fprintf(stderr, "Failed to open %s\n", trajectoryPath.c_str());
+		return 1;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	RecordingPlayer replay(recording);
+	auto pFrameStats = std::make_unique<FrameStats>();
+	fprintf(pOut, "frame,level,x,y,z,rotation_y,grounded\n");
+	while (replay.Step(*pFrameStats))
+	{
+		pFrameStats->EndFrame(replay.GetFrame(), replay.GetInput().dt * 1000.0f, 0.0f);
+
+		const PlayerPhysics& player = replay.GetSimulation().player;
+		const Float3& position = player.GetPosition();
+		fprintf(pOut, "%zu,%d,%.9g,%.9g,%.9g,%.9g,%d\n", replay.GetFrame(), replay.GetLevelNum(), position.x, position.y, position.z,
+			player.GetRotationY(), player.IsGrounded() ? 1 : 0);
+	}
+	const double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	if (pOut != stdout)
+	{
+		fclose(pOut);
+	}
+	fprintf(stderr, "Replayed %zu frames from level %d to level %d in %.2f ms\n", recording.GetFrameCount(), recording.GetStartLevel(), replay.GetLevelNum(), milliseconds);
+	return 0;
+}
+
+//Replays a recording and compares the simulation's state hash after every frame with the one recorded, stopping at the first that differs
+//Exits with 1 on a divergence, so a change that was meant to leave gameplay alone can be checked against a set of recordings
+static int CheckBench(const std::string& recordingPath, const std::string& gameFolder)
+{
+	InputRecording recording;
+	if (!recording.Load(recordingPath))
+	{
+		fprintf(stderr, "Failed to load %s\n", recordingPath.c_str());
+		return 1;
+	}
+	if (!recording.HasStateHashes())
+	{
+		fprintf(stderr, "%s has no state hashes, rehash it first\n", recordingPath.c_str());
+		return 1;
+	}
+	MountGameFolder(gameFolder);
+
+	RecordingPlayer replay(recording);
+	auto pFrameStats = std::make_unique<FrameStats>();
+	while (replay.Step(*pFrameStats))
+	{
+		const size_t frame = replay.GetFrame();
+		pFrameStats->EndFrame(frame, replay.GetInput().dt * 1000.0f, 0.0f);
+
+		const uint64_t stateHash = replay.GetSimulation().GetStateHash();
+		if (stateHash == recording.GetStateHash(frame))
+		{
+			continue;
+		}
+
+		const PlayerPhysics& player = replay.GetSimulation().player;
+		const Float3& position = player.GetPosition();
+		const Float3& velocity = player.GetVelocity();
+		printf("%s diverged on frame %zu of %zu\n", recordingPath.c_str(), frame, recording.GetFrameCount());
+		printf("  recorded hash %016llx, replayed hash %016llx\n", static_cast<unsigned long long>(recording.GetStateHash(frame)),
+			static_cast<unsigned long long>(stateHash));
+		printf("  level %d, position %.9g %.9g %.9g, velocity %.9g %.9g %.9g, rotation %.9g, %s\n", replay.GetLevelNum(),
+			position.x, position.y, position.z, velocity.x, velocity.y, velocity.z, player.GetRotationY(), player.IsGrounded() ? "grounded" : "airborne");
+		return 1;
+	}
+
+	printf("%s matches on all %zu frames\n", recordingPath.c_str(), recording.GetFrameCount());
+	return 0;
+}
+
+//Replays a recording and saves it with the state hashes of this build, for recordings from before the hashes or after a deliberate gameplay change
+static int RehashBench(const std::string& recordingPath, const std::string& outputPath, const std::string& gameFolder)
+{
+	InputRecording recording;
+	if (!recording.Load(recordingPath))
+	{
+		fprintf(stderr, "Failed to load %s\n", recordingPath.c_str());
+		return 1;
+	}
+	MountGameFolder(gameFolder);
+
+	InputRecording rehashed;
+	rehashed.Start(recording.GetStartLevel());
+	RecordingPlayer replay(recording);
+	auto pFrameStats = std::make_unique<FrameStats>();
+	while (replay.Step(*pFrameStats))
+	{
+		pFrameStats->EndFrame(replay.GetFrame(), replay.GetInput().dt * 1000.0f, 0.0f);
+		rehashed.Add(recording.GetFrame(replay.GetFrame()), replay.GetSimulation().GetStateHash());
+	}
+
+	if (!rehashed.Save(outputPath))
+	{
+		fprintf(stderr, "Failed to save %s\n", outputPath.c_str());
+		return 1;
+	}
+	fprintf(stderr, "Rehashed %zu frames into %s\n", rehashed.GetFrameCount(), outputPath.c_str());
+	return 0;
+}
+
+//Writes one case of the replay suite in the suite's layout, with the tail of the distribution after the fields compare reads
+static void WriteReplayCase(const std::string& name, size_t frames, std::vector<double>& times, bool last)
+{
+	std::sort(times.begin(), times.end());
+	printf("{\"name\":\"%s\",\"items\":%zu,\"median_ms\":%.6f,\"min_ms\":%.6f,\"p95_ms\":%.6f,\"p99_ms\":%.6f,\"max_ms\":%.6f}%s\n", name.c_str(), frames,
+		Percentile(times, 0.5), times.front(), Percentile(times, 0.95), Percentile(times, 0.99), times.back(), last ? "" : ",");
+}
+
+//Plays recordings headless through the simulation and the null renderer at a fixed timestep, doing the work of Game::UpdateFrame without a window
+//Each recording is played once untimed and then runs more times, the frame and phase times of every timed frame make up its distributions
+//Runs after the first restart from a snapshot of the start, so a large level is not built again for every run
+//The counters are those of one run, they depend only on the recording and the code so any change in them is a change in the work done
+static int ReplaySuiteBench(const std::vector<std::string>& recordingPaths, int runs, float dt, const std::string& gameFolder)
+{
+	if (recordingPaths.empty())
+	{
+		fprintf(stderr, "No recordings to play\n");
+		return 1;
+	}
+	MountGameFolder(gameFolder);
+
+	struct ReplayResult
+	{
+		std::string name;
+		size_t frames;
+		std::vector<double> frameTimes;
+		std::vector<double> phaseTimes[FrameStats::PhaseCount];
+		uint64_t counters[PerfCounters::CounterCount];
+	};
+	std::vector<ReplayResult> results;
+
+	for (const std::string& recordingPath : recordingPaths)
+	{
+		InputRecording recording;
+		if (!recording.Load(recordingPath))
+		{
+			fprintf(stderr, "Failed to load %s\n", recordingPath.c_str());
+			return 1;
+		}
+		if (recording.GetFrameCount() == 0)
+		{
+			fprintf(stderr, "%s has no frames\n", recordingPath.c_str());
+			return 1;
+		}
+
+		ReplayResult result = {};
+		result.name = "replay/" + std::filesystem::path(recordingPath).stem().string();
+		result.frames = recording.GetFrameCount();
+		//Reserved up front, so collecting the times does not allocate in the frames being measured
+		result.frameTimes.reserve(recording.GetFrameCount() * runs);
+		for (std::vector<double>& phaseTimes : result.phaseTimes)
+		{
+			phaseTimes.reserve(recording.GetFrameCount() * runs);
+		}
+
+		RecordingPlayer replay(recording, dt);
+		NullRenderer renderer;
+		for (int run = 0; run <= runs; run++)
+		{
+			if (run > 0)
+			{
+				replay.Restart();
+			}
+			auto pFrameStats = std::make_unique<FrameStats>();
+			std::fill(std::begin(result.counters), std::end(result.counters), 0);
+
+			//The first level is built before the game's first frame too, so its counts are left out
+			PerfCounters::EndFrame();
+
+			while (true)
+			{
+				const AllocationScope allocations;
+				const auto start = std::chrono::steady_clock::now();
+				if (!replay.Step(*pFrameStats))
+				{
+					break;
+				}
+				renderer.Publish(replay.GetLevel(), replay.GetSimulation().player, *pFrameStats);
+				const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				pFrameStats->EndFrame(replay.GetFrame(), replay.GetInput().dt * 1000.0f, milliseconds, allocations.GetAllocations());
+				PerfCounters::Add(PerfCounters::AllocationCounter, allocations.GetAllocations());
+				PerfCounters::EndFrame();
+				for (int counter = 0; counter < PerfCounters::CounterCount; counter++)
+				{
+					result.counters[counter] += PerfCounters::GetLastFrame(PerfCounters::Counter(counter));
+				}
+
+				if (run > 0)
+				{
+					const FrameStats::Frame& frame = pFrameStats->GetFrame(pFrameStats->GetFrameCount() - 1);
+					result.frameTimes.push_back(milliseconds);
+					for (int phase = 0; phase < FrameStats::PhaseCount; phase++)
+					{
+						result.phaseTimes[phase].push_back(frame.phaseMilliseconds[phase]);
+					}
+				}
+			}
+		}
+
+		fprintf(stderr, "%-32s %10.3f ms median frame over %zu frames, level %d\n", result.name.c_str(), Median(result.frameTimes), result.frames, recording.GetStartLevel());
+		results.push_back(std::move(result));
+	}
+
+	JobSystem::Stop();
+
+	printf("{\n\"version\": 1,\n\"runs\": %d,\n\"dt\": %.9g,\n\"benchmarks\": [\n", runs, dt);
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		ReplayResult& result = results[i];
+
+		//Phases the headless frame never runs, like the camera, are left out
+		std::vector<int> phases;
+		for (int phase = 0; phase < FrameStats::PhaseCount; phase++)
+		{
+			const std::vector<double>& phaseTimes = result.phaseTimes[phase];
+			if (std::any_of(phaseTimes.begin(), phaseTimes.end(), [](double time) { return time > 0.0; }))
+			{
+				phases.push_back(phase);
+			}
+		}
+
+		WriteReplayCase(result.name + "/frame", result.frames, result.frameTimes, false);
+		for (size_t j = 0; j < phases.size(); j++)
+		{
+			WriteReplayCase(result.name + "/" + FrameStats::GetPhaseName(FrameStats::Phase(phases[j])), result.frames, result.phaseTimes[phases[j]],
+				i + 1 == results.size() && j + 1 == phases.size());
+		}
+	}
+	printf("],\n\"counters\": [\n");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const ReplayResult& result = results[i];
+		for (int counter = 0; counter < PerfCounters::CounterCount; counter++)
+		{
+			printf("{\"name\":\"%s/%s\",\"total\":%llu,\"per_frame\":%.3f}%s\n", result.name.c_str(), PerfCounters::GetName(PerfCounters::Counter(counter)),
+				static_cast<unsigned long long>(result.counters[counter]), double(result.counters[counter]) / double((std::max)(result.frames, size_t(1))),
+				i + 1 == results.size() && counter + 1 == PerfCounters::CounterCount ? "" : ",");
+		}
+	}
+	printf("]\n}\n");
+	return 0;
+}
+
+//Buttons an instance holds for a second at a time, from a hash of the instance and the second so every thread count steps the same inputs
+static uint16_t GetBatchButtons(size_t instance, int frame) noexcept
+{
+	uint64_t bits = (uint64_t(instance) << 32 | uint64_t(frame / 60)) + 0x9E3779B97F4A7C15ull;
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ull;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBull;
+	bits ^= bits >> 31;
+
+	//Mostly forward, so the instances spread over the level rather than jittering around the spawn point
+	uint16_t buttons = (bits & 3) != 0 ? InputFrame::ForwardButton : 0;
+	buttons |= (bits >> 2 & 1) ? InputFrame::JumpButton : 0;
+	buttons |= (bits >> 3 & 3) == 1 ? InputFrame::TurnLeftButton : (bits >> 3 & 3) == 2 ? InputFrame::TurnRightButton : 0;
+	buttons |= (bits >> 5 & 7) == 0 ? InputFrame::LeftButton : (bits >> 5 & 7) == 1 ? InputFrame::RightButton : 0;
+	return buttons;
+}
+
+//Where every instance ended up, for comparing the thread counts
+static uint64_t HashBatch(const SimulationBatch& batch)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < batch.GetInstanceCount(); i++)
+	{
+		for (const float value : { batch.positionX[i], batch.positionY[i], batch.positionZ[i], batch.velocityX[i], batch.velocityY[i], batch.velocityZ[i] })
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			hash = (hash ^ bits) * 1099511628211ull;
+		}
+		hash = (hash ^ batch.collected[i]) * 1099511628211ull;
+		hash = (hash ^ batch.done[i]) * 1099511628211ull;
+	}
+	return hash;
+}
+
+//Steps many instances of a level in lockstep through SimulationBatch at 1, 2, 4 ... threads, each holding its own random buttons
+//Every thread count has to end in the same state, and the first instance is stepped through a Simulation alongside to check it moves the same way
+static int BatchBench(size_t instanceCount, int frames, int levelNum, size_t maxThreads, const std::string& gameFolder)
+{
+	MountGameFolder(gameFolder);
+	const auto buildStart = std::chrono::steady_clock::now();
+	SimulationBatch batch(levelNum, instanceCount);
+	const double buildMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - buildStart).count();
+	JobSystem::Stop();
+
+	printf("%zu instances of level %d, %d frames, %u hardware threads\n", instanceCount, levelNum, frames, std::thread::hardware_concurrency());
+	printf("shared level %zu bytes built in %.1f ms, %zu bytes per instance, %zu bytes of instance state\n", batch.GetLevel().GetChunkBytes(), buildMilliseconds,
+		batch.GetInstanceBytes(), MemoryTracker::GetUsage(MemoryTracker::BatchCategory).bytes);
+	printf("%-8s %10s %9s %16s %8s %10s\n", "threads", "frame ms", "speed-up", "instance steps/s", "done", "collected");
+
+	std::vector<InputFrame> inputs(instanceCount);
+	const float dt = 1.0f / 60.0f;
+	double baseMilliseconds = 0.0;
+	uint64_t expectedHash = 0;
+	bool mismatch = false;
+
+	for (const size_t threads : GetThreadCounts(maxThreads))
+	{
+		JobSystem::Start(threads);
+		batch.Reset();
+
+		//The same level stepped the ordinary way, streamed around its player like the game
+		std::unique_ptr<LevelState> pLevel;
+		Simulation simulation;
+		auto pFrameStats = std::make_unique<FrameStats>();
+		bool simulationDone = false;
+		if (threads == 1)
+		{
+			ChunkStreamer::Settings settings;
+			settings.synchronous = true;
+			pLevel = LevelState::BuildHeadless(levelNum, settings);
+			simulation.SetLevel(pLevel.get());
+		}
+
+		std::vector<double> times;
+		for (int frame = 0; frame < frames; frame++)
+		{
+			for (size_t i = 0; i < instanceCount; i++)
+			{
+				inputs[i] = { dt, GetBatchButtons(i, frame) };
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			batch.Step(inputs.data());
+			times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+			if (pLevel == nullptr || simulationDone)
+			{
+				continue;
+			}
+			simulationDone = simulation.Step(inputs[0], *pFrameStats);
+			pFrameStats->EndFrame(frame, dt * 1000.0f, 0.0f);
+			const Float3& position = simulation.player.GetPosition();
+			const Float3& velocity = simulation.player.GetVelocity();
+			if (position.x != batch.positionX[0] || position.y != batch.positionY[0] || position.z != batch.positionZ[0] ||
+				velocity.x != batch.velocityX[0] || velocity.y != batch.velocityY[0] || velocity.z != batch.velocityZ[0] ||
+				simulationDone != (batch.done[0] != 0))
+			{
+				fprintf(stderr, "Instance 0 left the simulation's path on frame %d, at %.9g %.9g %.9g instead of %.9g %.9g %.9g\n", frame,
+					batch.positionX[0], batch.positionY[0], batch.positionZ[0], position.x, position.y, position.z);
+				mismatch = true;
+				simulationDone = true;
+			}
+		}
+		JobSystem::Stop();
+
+		size_t doneCount = 0;
+		uint64_t collectedCount = 0;
+		for (size_t i = 0; i < instanceCount; i++)
+		{
+			doneCount += batch.done[i];
+			collectedCount += batch.collected[i];
+		}
+
+		const double milliseconds = Median(times);
+		if (threads == 1)
+		{
+			baseMilliseconds = milliseconds;
+			expectedHash = HashBatch(batch);
+		}
+		else if (HashBatch(batch) != expectedHash)
+		{
+			mismatch = true;
+		}
+
+		printf("%-8zu %10.3f %8.2fx %16.0f %8zu %10llu\n", threads, milliseconds, baseMilliseconds / milliseconds,
+			double(instanceCount) * 1000.0 / milliseconds, doneCount, static_cast<unsigned long long>(collectedCount));
+	}
+
+	if (mismatch)
+	{
+		fprintf(stderr, "The batch did not step the same way on every thread count, or as the simulation does\n");
+		return 1;
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[])
+{
+	const std::string command = argc > 1 ? argv[1] : "";
+
+	if (command == "jobs" && argc <= 5)
+	{
+		const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		return JobsBench(argc > 2 ? static_cast<size_t>(std::max(1, atoi(argv[2]))) : 50000, argc > 3 ? std::max(1, atoi(argv[3])) : 60,
+			argc > 4 ? static_cast<size_t>(std::max(1, atoi(argv[4]))) : hardwareThreads);
+	}
+
+	if (command == "level-build" && argc <= 5)
+	{
+		const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		return LevelBuildBench(argc > 2 ? static_cast<uint32_t>(std::max(1, std::min(65535, atoi(argv[2])))) : 2048, argc > 3 ? std::max(1, atoi(argv[3])) : 5,
+			argc > 4 ? static_cast<size_t>(std::max(1, atoi(argv[4]))) : hardwareThreads);
+	}
+
+	if (command == "allocations" && argc <= 4)
+	{
+		return AllocationsBench(argc > 2 ? static_cast<uint32_t>(std::max(1, std::min(65535, atoi(argv[2])))) : 256, argc > 3 ? std::max(1, atoi(argv[3])) : 5000);
+	}
+
+	if (command == "suite" && argc <= 4)
+	{
+		return SuiteBench(argc > 2 ? std::max(1, atoi(argv[2])) : 15, argc > 3 ? argv[3] : "../../3D-Platformer/3DObjects");
+	}
+
+	if (command == "compare" && argc >= 4 && argc <= 6)
+	{
+		return CompareSuites(argv[2], argv[3], argc > 4 ? atof(argv[4]) : 10.0, argc > 5 ? atof(argv[5]) : 0.0);
+	}
+
+	if (command == "counters" && argc <= 5 && (argc <= 4 || std::string(argv[4]) == "csv" || std::string(argv[4]) == "json"))
+	{
+		return CountersBench(argc > 2 ? static_cast<uint32_t>(std::max(1, std::min(65535, atoi(argv[2])))) : 256, argc > 3 ? std::max(1, atoi(argv[3])) : 600,
+			argc > 4 && std::string(argv[4]) == "json");
+	}
+
+	if (command == "replay" && argc >= 3 && argc <= 5)
+	{
+		return ReplayBench(argv[2], argc > 3 ? argv[3] : "", argc > 4 ? argv[4] : "../../3D-Platformer");
+	}
+
+	//Options follow the recordings, -runs N, -dt seconds with 0 for the recorded frame times, and -game folder
+	if (command == "replay-suite" && argc >= 3)
+	{
+		std::vector<std::string> recordingPaths;
+		int runs = 5;
+		float dt = 1.0f / 60.0f;
+		std::string gameFolder = "../../3D-Platformer";
+		for (int i = 2; i < argc; i++)
+		{
+			const std::string argument = argv[i];
+			if (argument == "-runs" && i + 1 < argc)
+			{
+				runs = std::max(1, atoi(argv[++i]));
+			}
+			else if (argument == "-dt" && i + 1 < argc)
+			{
+				dt = std::max(0.0f, float(atof(argv[++i])));
+			}
+			else if (argument == "-game" && i + 1 < argc)
+			{
+				gameFolder = argv[++i];
+			}
+			else
+			{
+				recordingPaths.push_back(argument);
+			}
+		}
+		return ReplaySuiteBench(recordingPaths, runs, dt, gameFolder);
+	}
+
+	if (command == "check" && argc >= 3 && argc <= 4)
+	{
+		return CheckBench(argv[2], argc > 3 ? argv[3] : "../../3D-Platformer");
+	}
+
+	if (command == "rehash" && argc >= 4 && argc <= 5)
+	{
+		return RehashBench(argv[2], argv[3], argc > 4 ? argv[4] : "../../3D-Platformer");
+	}
+
+	if (command == "batch" && argc <= 7)
+	{
+		const size_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+		return BatchBench(argc > 2 ? static_cast<size_t>(std::max(1, atoi(argv[2]))) : 1024, argc > 3 ? std::max(1, atoi(argv[3])) : 600,
+			argc > 4 ? std::max(1, atoi(argv[4])) : 1, argc > 5 ? static_cast<size_t>(std::max(1, atoi(argv[5]))) : hardwareThreads,
+			argc > 6 ? argv[6] : "../../3D-Platformer");
+	}
+
+	fprintf(stderr,
+		"usage: Benchmark jobs [objects] [frames] [max threads]\n"
+		"       Benchmark level-build [size] [runs] [max threads]\n"
+		"       Benchmark allocations [size] [frames]\n"
+		"       Benchmark counters [size] [frames] [csv|json]\n"
+		"       Benchmark suite [runs] [model folder] > results.json\n"
+		"       Benchmark compare base.json head.json [threshold %%] [counter threshold %%]\n"
+		"       Benchmark replay recording.inp [trajectory.csv] [game folder]\n"
+		"       Benchmark check recording.inp [game folder]\n"
+		"       Benchmark rehash recording.inp output.inp [game folder]\n"
+		"       Benchmark replay-suite recording.inp... [-runs N] [-dt seconds] [-game folder] > replays.json\n"
+		"       Benchmark batch [instances] [frames] [level] [max threads] [game folder]\n");
+	return 1;
+}